@@ -328,7 +328,7 @@ static void _signal_handler(const int sig) {
 }
 
 //* Config init
-void init_config(bool low_color, std::optional<std::string>& filter) {
+void init_config(bool low_color, std::optional<std::string>& filter, std::optional<std::string>& cgroup) {
 	atomic_lock lck(Global::init_conf);
 	vector<string> load_warnings;
 	Config::load(Config::conf_file, load_warnings);
@@ -346,6 +346,10 @@ void init_config(bool low_color, std::optional<std::string>& filter) {
 		Config::set("proc_filter", filter.value());
 	}
 
+	if (cgroup.has_value()) {
+		Config::set("proc_cgroup", cgroup.value());
+	}
+
 	static string log_level;
 	if (const string current_level = Config::getS("log_level"); log_level != current_level) {
 		log_level = current_level;
@@ -538,6 +542,9 @@ namespace Runner {
 
 			//* Run collection and draw functions for all boxes
 			try {
+				//? Sample system wide values once for all boxes of this update
+				if (not conf.no_update) Shared::update_tick();
+
 			#ifdef GPU_SUPPORT
 				//? GPU data collection
 				const bool gpu_in_cpu_panel = Gpu::gpu_names.size() > 0 and (
@@ -656,6 +663,10 @@ namespace Runner {
 						//? Start collect
 						auto proc = Proc::collect(conf.no_update);
 
+						//? Program view, one row per program name
+						if (Config::getB("proc_group_programs") and not Config::getB("proc_cgroup_view"))
+							Proc::aggregate(proc, Config::getS("proc_sorting"), Config::getB("proc_reversed"));
+
 						if (Global::debug) debug_timer("proc", draw_begin);
 
 						//? Draw box
@@ -963,7 +974,7 @@ static auto configure_tty_mode(std::optional<bool> force_tty) {
 	}
 
 	//? Config init
-	init_config(cli.low_color, cli.filter);
+	init_config(cli.low_color, cli.filter, cli.cgroup);
 
 	//? Try to find and set a UTF-8 locale
 	if (std::setlocale(LC_ALL, "") != nullptr and not std::string_view { std::setlocale(LC_ALL, "") }.contains(";")
@@ -1155,7 +1166,7 @@ static auto configure_tty_mode(std::optional<bool> force_tty) {
 				Global::reload_conf = false;
 				if (Runner::active) Runner::stop();
 				Config::unlock();
-				init_config(cli.low_color, cli.filter);
+				init_config(cli.low_color, cli.filter, cli.cgroup);
 				Theme::updateThemes();
 				Theme::setTheme();
 				Draw::banner_gen(0, 0, false, true);
@@ -104,6 +104,17 @@ namespace Cli {
 				continue;
 			}
 
+			if (arg == "--cgroup") {
+				// This flag requires an argument.
+				if (++it == args.end()) {
+					error("Cgroup requires an argument");
+					return std::unexpected { 1 };
+				}
+
+				auto arg = *it;
+				cli.cgroup = std::make_optional(arg);
+				continue;
+			}
 			if (arg == "-c" || arg == "--config") {
 				// This flag requires an argument.
 				if (++it == args.end()) {
@@ -249,6 +260,7 @@ namespace Cli {
 	void help() noexcept {
 		fmt::print(
 			"{0}Options:{1}\n"
+			"  {2}    --cgroup{1} <path>     Only show processes in a cgroup v2 and the cgroups below it (Linux)\n"
 			"  {2}-c, --config{1} <file>     Path to a config file\n"
 			"  {2}-d, --debug{1}             Start in debug mode with additional logs and metrics\n"
 			"  {2}-f, --filter{1} <filter>   Set an initial process filter\n"
@@ -14,6 +14,8 @@ namespace Cli {
 
 	// Configuration options set via the command line.
 	struct Cli {
+		// Only show processes in this cgroup
+		std::optional<std::string> cgroup;
 		// Alternate path to a configuration file
 		std::optional<stdfs::path> config_file;
 		// Enable debug mode with additional logs and metrics
@@ -99,6 +99,8 @@ namespace Config {
 		{"update_ms", 			"#* Update time in milliseconds, recommended 2000 ms or above for better sample times for graphs."},
 
 		{"proc_sorting",		"#* Processes sorting, \"pid\" \"program\" \"arguments\" \"threads\" \"user\" \"memory\" \"cpu lazy\" \"cpu direct\",\n"
+								"#* \"minor faults\" \"major faults\" \"top waiters\" (Linux),\n"
+								"#* \"top waiters\" sorts by time spent waiting for a cpu, which is read for all processes every 5 updates,\n"
 								"#* \"cpu lazy\" sorts top process over time (easier to follow), \"cpu direct\" updates top process directly."},
 
 		{"proc_reversed",		"#* Reverse sorting order, True or False."},
@@ -115,12 +117,36 @@ namespace Config {
 
 		{"proc_cpu_graphs",     "#* Show cpu graph for each process."},
 
-		{"proc_info_smaps",		"#* Use /proc/[pid]/smaps for memory information in the process info box (very slow but more accurate)"},
+		{"proc_info_smaps",		"#* Use /proc/[pid]/smaps_rollup for memory information in the process info box, adds PSS and USS graphs and shows swap next to RSS.\n"
+								"#* Falls back to /proc/[pid]/smaps on kernels older than 4.14, which is very slow for processes with many mappings."},
 
 		{"proc_left",			"#* Show proc box on left side of screen instead of right."},
 
 		{"proc_filter_kernel",  "#* (Linux) Filter processes tied to the Linux kernel(similar behavior to htop)."},
 
+		{"proc_collect_threads", "#* (Linux) Number of threads used to read process information from /proc, 1 disables the worker threads. Max 64."},
+
+		{"proc_events",			"#* (Linux) Track processes with kernel process events instead of scanning /proc every update, needs root or CAP_NET_ADMIN.\n"
+								"#* Also shows processes that started and exited between two updates. Falls back to scanning /proc if not available."},
+
+		{"proc_idle_refresh",	"#* (Linux) Processes that used no cpu time when last read are only read from /proc every N updates, 1 reads all processes every update. Max 100."},
+
+		{"proc_cmd_refresh",	"#* (Linux) Re-read name, command line and user of running processes every N updates, 0 only reads them when a process starts or the pid is reused.\n"
+								"#* With proc_events enabled they are also re-read after exec()."},
+
+		{"proc_columns",		"#* (Linux) Extra columns in the process list, only read for processes in or near the visible part of the list.\n"
+								"#* Available values are \"io_read io_write fds wait minflt majflt ctx_vol ctx_invol\", separate values with whitespace. Empty string to disable.\n"
+								"#* Page fault rates (minflt majflt) come from the stat file that is read anyway and are known for all processes."},
+
+		{"proc_cgroup",			"#* (Linux) Only show processes in this cgroup v2 and the cgroups below it, e.g. \"/system.slice/nginx.service\".\n"
+								"#* The path is relative to the cgroup2 mount point. Cpu and mem boxes also show usage of the cgroup. Empty string to disable."},
+
+		{"proc_cgroup_view",	"#* (Linux) List cgroups with their cpu, memory, io and throttling instead of processes, toggle with \"v\" in the process box.\n"
+								"#* Usage is read once per cgroup, processes are only read after selecting a cgroup with enter, escape goes back to the view.\n"
+								"#* Sorted by memory, by path for the name sortings, by throttled time for \"top waiters\" and by cpu for the rest."},
+
+		{"proc_group_programs",	"#* Show one row per program name with the number of processes and their summed cpu, memory and threads, toggle with \"A\" in the process box."},
+
 		{"proc_follow_detailed",	"#* Should the process list follow the selected process when detailed view is open."},
 
 		{"proc_aggregate",		"#* In tree-view, always accumulate child process resources in the parent process."},
@@ -163,6 +189,8 @@ namespace Config {
 		{"show_cpu_freq", 		"#* Show CPU frequency."},
 	#ifdef __linux__
 		{"freq_mode",				"#* How to calculate CPU frequency, available values: \"first\", \"range\", \"lowest\", \"highest\" and \"average\"."},
+
+		{"show_core_freq",		"#* Show the frequency of each core next to its usage, colored by its share of the core's maximum frequency."},
 	#endif
 		{"clock_format", 		"#* Draw a clock at top of screen, formatting according to strftime, empty string to disable.\n"
 								"#* Special formatting: /host = hostname | /user = username | /uptime = system uptime"},
@@ -272,6 +300,9 @@ namespace Config {
 		{"log_level", "WARNING"},
 		{"proc_filter", ""},
 		{"proc_command", ""},
+		{"proc_columns", ""},
+		{"proc_cgroup", ""},
+		{"proc_cgroup_scope", ""},
 		{"selected_name", ""},
 	#ifdef GPU_SUPPORT
 		{"custom_gpu_name0", ""},
@@ -305,6 +336,9 @@ namespace Config {
 		{"proc_info_smaps", false},
 		{"proc_left", false},
 		{"proc_filter_kernel", false},
+		{"proc_events", false},
+		{"proc_cgroup_view", false},
+		{"proc_group_programs", false},
 		{"cpu_invert_lower", true},
 		{"cpu_single_graph", false},
 		{"cpu_bottom", false},
@@ -313,6 +347,7 @@ namespace Config {
 		{"check_temp", true},
 		{"show_coretemp", true},
 		{"show_cpu_freq", true},
+		{"show_core_freq", false},
 		{"background_update", true},
 		{"mem_graphs", true},
 		{"mem_below_net", false},
@@ -371,6 +406,9 @@ namespace Config {
 		{"proc_selected", 0},
 		{"proc_last_selected", 0},
 		{"proc_followed", 0},
+		{"proc_collect_threads", 1},
+		{"proc_idle_refresh", 1},
+		{"proc_cmd_refresh", 0},
 	};
 	std::unordered_map<std::string_view, int> intsTmp;
 
@@ -556,6 +594,15 @@ namespace Config {
 		else if (name == "update_ms" and i_value > ONE_DAY_MILLIS)
 			validError = fmt::format("Config value update_ms set too high (>{}).", ONE_DAY_MILLIS);
 
+		else if (name == "proc_collect_threads" and (i_value < 1 or i_value > 64))
+			validError = "Config value proc_collect_threads must be between 1 and 64.";
+
+		else if (name == "proc_idle_refresh" and (i_value < 1 or i_value > 100))
+			validError = "Config value proc_idle_refresh must be between 1 and 100.";
+
+		else if (name == "proc_cmd_refresh" and (i_value < 0 or i_value > 10000))
+			validError = "Config value proc_cmd_refresh must be between 0 and 10000.";
+
 		else
 			return true;
 
@@ -596,6 +643,9 @@ namespace Config {
 		else if (name == "presets" and not presetsValid(value))
 			return false;
 
+		else if (name == "proc_columns" and not rng::all_of(ssplit(value), [](const auto& column) { return v_contains(valid_proc_columns, column); }))
+			validError = "Invalid column name(s) in proc_columns!";
+
 		else if (name == "cpu_core_map") {
 			const auto maps = ssplit(value);
 			bool all_good = true;
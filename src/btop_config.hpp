@@ -50,6 +50,7 @@ namespace Config {
 #endif
 		};
 	const vector<string> temp_scales = { "celsius", "fahrenheit", "kelvin", "rankine" };
+	const vector<string> valid_proc_columns = { "io_read", "io_write", "fds", "wait", "minflt", "majflt", "ctx_vol", "ctx_invol" };
 #ifdef __linux__
 	const vector<string> freq_modes = { "first", "range", "lowest", "highest", "average" };
 #endif
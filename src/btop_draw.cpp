@@ -392,14 +392,17 @@ namespace Draw {
 	}
 
 	//* Graph class ------------------------------------------------------------------------------------------------------------>
-	void Graph::_create(const deque<long long>& data, int data_offset) {
+	void Graph::_create(const RingBuffer<long long>& data, int data_offset) {
 		bool mult = (data.size() - data_offset > 1);
+		//? Values are read from the two contiguous halves of the ring buffer instead of wrapping every index
+		const auto [data_first, data_second] = data.spans();
+		auto value_at = [&](int i) { return cmp_less(i, data_first.size()) ? data_first[i] : data_second[i - data_first.size()]; };
 		const auto& graph_symbol = Symbols::graph_symbols.at(symbol + '_' + (invert ? "down" : "up"));
 		array<int, 2> result;
 		const float mod = (height == 1) ? 0.3 : 0.1;
 		long long data_value = 0;
 		if (mult and data_offset > 0) {
-			last = data.at(data_offset - 1);
+			last = value_at(data_offset - 1);
 			if (max_value > 0) last = clamp((last + offset) * 100 / max_value, 0ll, 100ll);
 		}
 
@@ -412,7 +415,7 @@ namespace Draw {
 				last = 0;
 			}
 			else {
-				data_value = data.at(i);
+				data_value = value_at(i);
 				if (max_value > 0) data_value = clamp((data_value + offset) * 100 / max_value, 0ll, 100ll);
 			}
 
@@ -464,7 +467,7 @@ namespace Draw {
 	Graph::Graph() {}
 
 	Graph::Graph(int width, int height, const string& color_gradient,
-				 const deque<long long>& data, const string& symbol,
+				 const RingBuffer<long long>& data, const string& symbol,
 				 bool invert, bool no_zero, long long max_value, long long offset)
 	: width(width), height(height), color_gradient(color_gradient),
 	  invert(invert), no_zero(no_zero), offset(offset) {
@@ -491,7 +494,7 @@ namespace Draw {
 		this->_create(data, data_offset);
 	}
 
-	string& Graph::operator()(const deque<long long>& data, bool data_same) {
+	string& Graph::operator()(const RingBuffer<long long>& data, bool data_same) {
 		if (data_same) return out;
 
 		//? Make room for new characters on graph
@@ -542,6 +545,7 @@ namespace Cpu {
 		if (force_redraw) redraw = true;
 		bool show_temps = (Config::getB("check_temp") and got_sensors);
 		bool show_watts = (Config::getB("show_cpu_watts") and supports_watts);
+		const bool show_core_freq = (Config::getB("show_core_freq") and has_core_freq);
 		auto single_graph = Config::getB("cpu_single_graph");
 		bool hide_cores = show_temps and (cpu_temp_only or not Config::getB("show_coretemp"));
 		const int extra_width = (hide_cores ? max(6, 6 * b_column_size) : (b_columns == 1 && !show_temps) ? 8 : 0);
@@ -573,10 +577,10 @@ namespace Cpu {
 		const string& title_left = Theme::c("cpu_box") + (cpu_bottom ? Symbols::title_left_down : Symbols::title_left);
 		const string& title_right = Theme::c("cpu_box") + (cpu_bottom ? Symbols::title_right_down : Symbols::title_right);
 		static int bat_pos = 0, bat_len = 0;
-		if (safeVal(cpu.cpu_percent, "total"s).empty()
+		if (cpu.cpu_percent[cpu_field::total].empty()
 			or safeVal(cpu.core_percent, 0).empty()
 			or (show_temps and safeVal(cpu.temp, 0).empty())) return "";
-		if (safeVal(cpu.cpu_percent, "total"s).empty()
+		if (cpu.cpu_percent[cpu_field::total].empty()
 			or safeVal(cpu.core_percent, 0).empty()
 			or (show_temps and safeVal(cpu.temp, 0).empty())) return "";
 		string out;
@@ -679,7 +683,7 @@ namespace Cpu {
 						width_left -= 11;
 					}
 					if (gpu.supported_functions.mem_used and gpu.supported_functions.mem_total and b_columns > 1) {
-						gpu_mem_graphs[i] = Draw::Graph{ gpu_graph_width, 1, "used", safeVal(gpu.gpu_percent, "gpu-vram-totals"s), graph_symbol };
+						gpu_mem_graphs[i] = Draw::Graph{ gpu_graph_width, 1, "used", gpu.gpu_percent[Gpu::gpu_field::vram_totals], graph_symbol };
 						width_left -= 5;
 					}
 					width_left -= (gpu.supported_functions.mem_used ? 5 : 0);
@@ -813,7 +817,7 @@ namespace Cpu {
 
 			//? Uptime
 			if (Config::getB("show_uptime")) {
-				string upstr = sec_to_dhms(system_uptime());
+				string upstr = sec_to_dhms(Shared::tick.uptime);
 				if (upstr.size() > 8) {
 					upstr.resize(upstr.size() - 3);
 					upstr = trans(upstr);
@@ -834,8 +838,8 @@ namespace Cpu {
 					+ Symbols::h_line * ((freq_range ? 17 : 7) - cpuHz.size())
 					+ Symbols::title_left + Fx::b + Theme::c("title") + cpuHz + Fx::ub + Theme::c("div_line") + Symbols::title_right;
 
-		out += Mv::to(b_y + 1, b_x + 1) + Theme::c("main_fg") + Fx::b + "CPU " + cpu_meter(safeVal(cpu.cpu_percent, "total"s).back())
-			+ Theme::g("cpu").at(clamp(safeVal(cpu.cpu_percent, "total"s).back(), 0ll, 100ll)) + rjust(to_string(safeVal(cpu.cpu_percent, "total"s).back()), 4) + Theme::c("main_fg") + '%';
+		out += Mv::to(b_y + 1, b_x + 1) + Theme::c("main_fg") + Fx::b + "CPU " + cpu_meter(cpu.cpu_percent[cpu_field::total].back())
+			+ Theme::g("cpu").at(clamp(cpu.cpu_percent[cpu_field::total].back(), 0ll, 100ll)) + rjust(to_string(cpu.cpu_percent[cpu_field::total].back()), 4) + Theme::c("main_fg") + '%';
 		if (show_temps) {
 			const auto [temp, unit] = celsius_to(safeVal(cpu.temp, 0).back(), temp_scale);
 			const auto temp_color = Theme::g("temp").at(clamp(safeVal(cpu.temp, 0).back() * 100 / cpu.temp_max, 0ll, 100ll));
@@ -883,6 +887,17 @@ namespace Cpu {
 			out += enabled ? Theme::g("cpu").at(clamp(safeVal(cpu.core_percent, n).back(), 0ll, 100ll)) : Theme::c("inactive_fg");
 			out += rjust(to_string(safeVal(cpu.core_percent, n).back()), (b_column_size < 2 ? 3 : 4)) + Theme::c(enabled ? "main_fg" : "inactive_fg") + '%';
 
+			//? Current frequency in GHz, colored by its share of the maximum frequency of the core to make throttled cores stand out
+			if (show_core_freq) {
+				const long long mhz = (cmp_less(n, cpu.core_freq.size()) ? cpu.core_freq[n] : 0);
+				const long long max_mhz = (cmp_less(n, cpu.core_freq_max.size()) ? cpu.core_freq_max[n] : 0);
+				if (mhz > 0) {
+					out += (enabled and max_mhz > 0 ? Theme::g("cpu").at(clamp(mhz * 100 / max_mhz, 0ll, 100ll)) : Theme::c(enabled ? "main_fg" : "inactive_fg"))
+						+ rjust(fmt::format("{:.1f}", mhz / 1000.0), 4) + Theme::c(enabled ? "main_fg" : "inactive_fg") + 'G';
+				}
+				else out += Theme::c("inactive_fg") + rjust("-", 4) + ' ';
+			}
+
 			if (show_temps and not hide_cores) {
 				const auto [temp, unit] = celsius_to(safeVal(cpu.temp, n+1).back(), temp_scale);
 				const auto temp_color = enabled ? Theme::g("temp").at(clamp(safeVal(cpu.temp, n+1).back() * 100 / cpu.temp_max, 0ll, 100ll)) : Theme::c("inactive_fg");
@@ -913,6 +928,10 @@ namespace Cpu {
 
 			int len = load_avg_pre.size() + load_avg.size();
 			out += Mv::to(b_y + cy, b_x + 1) + string(max(b_width - len - 2, 0), ' ') + Theme::c("main_fg") + Fx::b + load_avg_pre + Fx::ub + load_avg;
+
+			//? Cpu usage of the cgroup selected with proc_cgroup, left of the load average if there is room
+			if (cpu.cgroup_percent >= 0 and b_width - len - 2 >= 14)
+				out += Mv::to(b_y + cy, b_x + 1) + Fx::b + "Cgroup:" + Fx::ub + fmt::format("{:>5.1f}%", cpu.cgroup_percent);
 		}
 
 	#ifdef GPU_SUPPORT
@@ -926,16 +945,16 @@ namespace Cpu {
 				if (gpus[i].supported_functions.gpu_utilization) {
 					out += ' ';
 					if (b_columns > 1) {
-					out += gpu_meters[i](safeVal(gpus[i].gpu_percent, "gpu-totals"s).back())
-						+ Theme::g("cpu").at(clamp(safeVal(gpus[i].gpu_percent, "gpu-totals"s).back(), 0ll, 100ll));
+					out += gpu_meters[i](gpus[i].gpu_percent[Gpu::gpu_field::totals].back())
+						+ Theme::g("cpu").at(clamp(gpus[i].gpu_percent[Gpu::gpu_field::totals].back(), 0ll, 100ll));
 					}
-					out += rjust(to_string(safeVal(gpus[i].gpu_percent, "gpu-totals"s).back()), 3) + Theme::c("main_fg") + '%';
+					out += rjust(to_string(gpus[i].gpu_percent[Gpu::gpu_field::totals].back()), 3) + Theme::c("main_fg") + '%';
 					if (b_columns == 1)
 						out += ' ';
 				}
 				if (gpus[i].supported_functions.mem_used and gpus[i].supported_functions.mem_total and b_columns > 1) {
-					out += ' ' + Theme::c("inactive_fg") + graph_bg * 5 + Mv::l(5) + Theme::g("used").at(safeVal(gpus[i].gpu_percent, "gpu-vram-totals"s).back())
-						+ gpu_mem_graphs[i](safeVal(gpus[i].gpu_percent, "gpu-vram-totals"s), data_same or redraw);
+					out += ' ' + Theme::c("inactive_fg") + graph_bg * 5 + Mv::l(5) + Theme::g("used").at(gpus[i].gpu_percent[Gpu::gpu_field::vram_totals].back())
+						+ gpu_mem_graphs[i](gpus[i].gpu_percent[Gpu::gpu_field::vram_totals], data_same or redraw);
 				}
 				if (gpus[i].supported_functions.mem_used) {
 						out += Theme::c("main_fg")
@@ -954,7 +973,7 @@ namespace Cpu {
 					out += rjust(to_string(temp), 3) + Theme::c("main_fg") + unit;
 				}
 				if (gpus[i].supported_functions.pwr_usage) {
-					out += ' ' + Theme::g("cached").at(clamp(safeVal(gpus[i].gpu_percent, "gpu-pwr-totals"s).back(), 0ll, 100ll))
+					out += ' ' + Theme::g("cached").at(clamp(gpus[i].gpu_percent[Gpu::gpu_field::pwr_totals].back(), 0ll, 100ll))
 						+ fmt::format("{:>4.{}f}", gpus[i].pwr_usage / 1000.0, gpus[i].pwr_usage < 10'000 ? 2 : gpus[i].pwr_usage < 100'000 ? 1 : 0) + Theme::c("main_fg") + 'W';
 				}
 
@@ -1026,12 +1045,12 @@ namespace Gpu {
 			int graph_low_height = single_graph ? 0 : b_height_vec[index] - graph_up_height;
 
 			if (gpu.supported_functions.gpu_utilization) {
-				graph_upper = Draw::Graph{x + width - b_width - 3, graph_up_height, "cpu", safeVal(gpu.gpu_percent, "gpu-totals"s), graph_symbol, false, true}; // TODO cpu -> gpu
+				graph_upper = Draw::Graph{x + width - b_width - 3, graph_up_height, "cpu", gpu.gpu_percent[gpu_field::totals], graph_symbol, false, true}; // TODO cpu -> gpu
             	if (not single_graph) {
                 	graph_lower = Draw::Graph{
                     	x + width - b_width - 3,
                     	graph_low_height, "cpu",
-                    	safeVal(gpu.gpu_percent, "gpu-totals"s),
+                    	gpu.gpu_percent[gpu_field::totals],
                     	graph_symbol,
                     	Config::getB("cpu_invert_lower"), true
                 	};
@@ -1045,7 +1064,7 @@ namespace Gpu {
 			if (gpu.supported_functions.mem_utilization)
 				mem_util_graph = Draw::Graph{b_width/2 - 1, 2, "free", gpu.mem_utilization_percent, graph_symbol, 0, 0, 100, 4}; // offset so the graph isn't empty at 0-5% utilization
 			if (gpu.supported_functions.mem_used and gpu.supported_functions.mem_total)
-				mem_used_graph = Draw::Graph{b_width/2 - 2, 2 + 2*(gpu.supported_functions.mem_utilization), "used", safeVal(gpu.gpu_percent, "gpu-vram-totals"s), graph_symbol};
+				mem_used_graph = Draw::Graph{b_width/2 - 2, 2 + 2*(gpu.supported_functions.mem_utilization), "used", gpu.gpu_percent[gpu_field::vram_totals], graph_symbol};
 			if (gpu.supported_functions.encoder_utilization)
 				enc_meter = Draw::Meter{b_width/2 - 10, "cpu"};
 		}
@@ -1055,12 +1074,12 @@ namespace Gpu {
 		int rows_used = 1;
 		//? Gpu graph, meter & clock speed
 		if (gpu.supported_functions.gpu_utilization) {
-			out += Fx::ub + Mv::to(y + rows_used, x + 1) + graph_upper(safeVal(gpu.gpu_percent, "gpu-totals"s), (data_same or redraw[index]));
+			out += Fx::ub + Mv::to(y + rows_used, x + 1) + graph_upper(gpu.gpu_percent[gpu_field::totals], (data_same or redraw[index]));
 			if (not single_graph)
-				out += Mv::to(y + rows_used + graph_up_height, x + 1) + graph_lower(safeVal(gpu.gpu_percent, "gpu-totals"s), (data_same or redraw[index]));
+				out += Mv::to(y + rows_used + graph_up_height, x + 1) + graph_lower(gpu.gpu_percent[gpu_field::totals], (data_same or redraw[index]));
 
-			out += Mv::to(b_y + rows_used, b_x + 1) + Theme::c("main_fg") + Fx::b + "GPU " + gpu_meter(safeVal(gpu.gpu_percent, "gpu-totals"s).back())
-				+ Theme::g("cpu").at(clamp(safeVal(gpu.gpu_percent, "gpu-totals"s).back(), 0ll, 100ll)) + rjust(to_string(safeVal(gpu.gpu_percent, "gpu-totals"s).back()), 5) + Theme::c("main_fg") + '%';
+			out += Mv::to(b_y + rows_used, b_x + 1) + Theme::c("main_fg") + Fx::b + "GPU " + gpu_meter(gpu.gpu_percent[gpu_field::totals].back())
+				+ Theme::g("cpu").at(clamp(gpu.gpu_percent[gpu_field::totals].back(), 0ll, 100ll)) + rjust(to_string(gpu.gpu_percent[gpu_field::totals].back()), 5) + Theme::c("main_fg") + '%';
 
 			//? Temperature graph, I assume the device supports utilization if it supports temperature
 			if (show_temps) {
@@ -1081,8 +1100,8 @@ namespace Gpu {
 
 		//? Power usage meter, power state
 		if (gpu.supported_functions.pwr_usage) {
-			out += Mv::to(b_y + rows_used, b_x + 1) + Theme::c("main_fg") + Fx::b + "PWR " + pwr_meter(safeVal(gpu.gpu_percent, "gpu-pwr-totals"s).back())
-				+ Theme::g("cached").at(clamp(safeVal(gpu.gpu_percent, "gpu-pwr-totals"s).back(), 0ll, 100ll))
+			out += Mv::to(b_y + rows_used, b_x + 1) + Theme::c("main_fg") + Fx::b + "PWR " + pwr_meter(gpu.gpu_percent[gpu_field::pwr_totals].back())
+				+ Theme::g("cached").at(clamp(gpu.gpu_percent[gpu_field::pwr_totals].back(), 0ll, 100ll))
 				+ fmt::format("{:>5.{}f}", gpu.pwr_usage / 1000.0, gpu.pwr_usage < 10'000 ? 2 : gpu.pwr_usage < 100'000 ? 1 : 0) + Theme::c("main_fg") + 'W';
 			if (gpu.supported_functions.pwr_state and gpu.pwr_state != 32) // NVML_PSTATE_UNKNOWN; unsupported or non-nvidia card
 				out += std::string(" P-state: ") + (gpu.pwr_state > 9 ? "" : " ") + 'P' + Theme::g("cached").at(clamp(gpu.pwr_state, 0ll, 100ll)) + to_string(gpu.pwr_state);
@@ -1112,9 +1131,9 @@ namespace Gpu {
 					+  Symbols::h_line*(b_width/2-8) + Symbols::div_up + Mv::d(offset)+Mv::l(1) + Symbols::div_down + Mv::l(1)+Mv::u(1) + (Symbols::v_line + Mv::l(1)+Mv::u(1))*(offset-1) + Symbols::div_up
 					+  Symbols::h_line + Theme::c("title") + "Used:" + Theme::c("div_line")
 					+  Symbols::h_line*(b_width/2+b_width%2-9-used_memory_string.size()) + Theme::c("title") + used_memory_string + Theme::c("div_line") + Symbols::h_line + Symbols::div_right
-					+  Mv::d(1) + Mv::l(b_width/2-1) + mem_used_graph(safeVal(gpu.gpu_percent, "gpu-vram-totals"s), (data_same or redraw[index]))
+					+  Mv::d(1) + Mv::l(b_width/2-1) + mem_used_graph(gpu.gpu_percent[gpu_field::vram_totals], (data_same or redraw[index]))
 					+  Mv::l(b_width-3) + Mv::u(1+2*gpu.supported_functions.mem_utilization) + Theme::c("main_fg") + Fx::b + "Total:" + rjust(floating_humanizer(gpu.mem_total), b_width/2-9) + Fx::ub
-					+  Mv::r(3) + rjust(to_string(safeVal(gpu.gpu_percent, "gpu-vram-totals"s).back()), 3) + '%';
+					+  Mv::r(3) + rjust(to_string(gpu.gpu_percent[gpu_field::vram_totals].back()), 3) + '%';
 
 				//? Memory utilization
 				if (gpu.supported_functions.mem_utilization)
@@ -1250,8 +1269,8 @@ namespace Mem {
 							//? Create one combined graph for IO read/write if enabled
 							long long speed = (custom_speeds.contains(name) ? custom_speeds.at(name) : 100) << 20;
 							if (io_graph_combined) {
-								deque<long long> combined(disk.io_read.size(), 0);
-								rng::transform(disk.io_read, disk.io_write, combined.begin(), std::plus<long long>());
+								RingBuffer<long long> combined;
+								rng::transform(disk.io_read, disk.io_write, std::back_inserter(combined), std::plus<long long>());
 								io_graphs[name] = Draw::Graph{
 									disks_width, disks_io_h, "available", combined,
 									graph_symbol, false, true, speed};
@@ -1303,7 +1322,7 @@ namespace Mem {
 					if (graph_height > 0) out += Mv::to(y+1+cy, x+1+cx) + divider;
 					cy += 1;
 				}
-				out += Mv::to(y+1+cy, x+1+cx) + Theme::c("title") + Fx::b + "Swap:" + rjust(floating_humanizer(safeVal(mem.stats, "swap_total"s)), mem_width - 8)
+				out += Mv::to(y+1+cy, x+1+cx) + Theme::c("title") + Fx::b + "Swap:" + rjust(floating_humanizer(mem.stats[mem_field::swap_total]), mem_width - 8)
 					+ Theme::c("main_fg") + Fx::ub;
 				cy += 1;
 				title = "Used";
@@ -1333,6 +1352,13 @@ namespace Mem {
 		if (graph_height > 0 and cy < height - 2)
 			out += Mv::to(y+1+cy, x+1+cx) + divider;
 
+		//? Memory use and limit of the cgroup selected with proc_cgroup in the bottom border, padded to keep the length fixed
+		if (mem.cgroup and width > 30) {
+			const string cgroup_mem = floating_humanizer(mem.cgroup_current, true) + (mem.cgroup_max > 0 ? '/' + floating_humanizer(mem.cgroup_max, true) : "");
+			out += Mv::to(y + height - 1, x + 2) + Theme::c("mem_box") + Symbols::title_left_down + Fx::b + Theme::c("title") + "cgroup "
+				+ Fx::ub + Theme::c("main_fg") + ljust(cgroup_mem, 11) + Theme::c("mem_box") + Symbols::title_right_down;
+		}
+
 		//? Disks
 		if (show_disks) {
 			const auto& disks = mem.disks;
@@ -1435,7 +1461,7 @@ namespace Net {
 	bool shown = true, redraw = true;
 	const int MAX_IFNAMSIZ = 15;
 	string old_ip;
-	std::unordered_map<string, Draw::Graph> graphs;
+	direction_map<Draw::Graph> graphs;
 	string box;
 
 	string draw(const net_info& net, bool force_redraw, bool data_same) {
@@ -1456,30 +1482,30 @@ namespace Net {
 		const string title_left = Theme::c("net_box") + Fx::ub + Symbols::title_left;
 		const string title_right = Theme::c("net_box") + Fx::ub + Symbols::title_right;
 		const int i_size = min((int)selected_iface.size(), MAX_IFNAMSIZ);
-		const long long down_max = (net_auto ? safeVal(graph_max, "download"s) : ((long long)(Config::getI("net_download")) << 20) / 8);
-		const long long up_max = (net_auto ? safeVal(graph_max, "upload"s) : ((long long)(Config::getI("net_upload")) << 20) / 8);
+		const long long down_max = (net_auto ? graph_max[direction::download] : ((long long)(Config::getI("net_download")) << 20) / 8);
+		const long long up_max = (net_auto ? graph_max[direction::upload] : ((long long)(Config::getI("net_upload")) << 20) / 8);
 
 		//* Redraw elements not needed to be updated every cycle
 		if (redraw) {
 			out = box;
 			//? Graphs
-			graphs.clear();
-			if (safeVal(net.bandwidth, "download"s).empty() or safeVal(net.bandwidth, "upload"s).empty())
+			graphs = {};
+			if (net.bandwidth[direction::download].empty() or net.bandwidth[direction::upload].empty())
 				return out + Fx::reset;
 
-			graphs["download"] = Draw::Graph{
+			graphs[direction::download] = Draw::Graph{
 				width - b_width - 2, u_graph_height, "download",
-				net.bandwidth.at("download"), graph_symbol,
+				net.bandwidth[direction::download], graph_symbol,
 				swap_upload_download, true, down_max};
-			graphs["upload"] = Draw::Graph{
+			graphs[direction::upload] = Draw::Graph{
 				width - b_width - 2, d_graph_height, "upload",
-				net.bandwidth.at("upload"), graph_symbol, !swap_upload_download, true, up_max};
+				net.bandwidth[direction::upload], graph_symbol, !swap_upload_download, true, up_max};
 
 			//? Interface selector and buttons
 
 			out += Mv::to(y, x+width - i_size - 9) + title_left + Fx::b + Theme::c("hi_fg") + Symbols::left + "b " + Theme::c("title")
 				+ uresize(selected_iface, MAX_IFNAMSIZ) + Theme::c("hi_fg") + " n" + Symbols::right + title_right
-				+ Mv::to(y, x+width - i_size - 15) + title_left + Theme::c("hi_fg") + (safeVal(net.stat, "download"s).offset + safeVal(net.stat, "upload"s).offset > 0 ? Fx::b : "") + 'z'
+				+ Mv::to(y, x+width - i_size - 15) + title_left + Theme::c("hi_fg") + (net.stat[direction::download].offset + net.stat[direction::upload].offset > 0 ? Fx::b : "") + 'z'
 				+ Theme::c("title") + "ero" + title_right;
 			Input::mouse_mappings["b"] = {y, x+width - i_size - 8, 1, 3};
 			Input::mouse_mappings["n"] = {y, x+width - 6, 1, 3};
@@ -1501,25 +1527,26 @@ namespace Net {
 		}
 
 		//? Graphs and stats
-		for (const string dir : {"download", "upload"}) {
+		for (const auto dir : {direction::download, direction::upload}) {
+			const auto& stat = net.stat[dir];
 			//         |  upload  |  download  |
 			// no swap |  bottom  |     top    |
 			//  swap   |    top   |   bottom   |
 			// XNOR operation (==)
-			if ((not swap_upload_download and dir == "download") or (swap_upload_download and dir == "upload")) {
+			if ((not swap_upload_download and dir == direction::download) or (swap_upload_download and dir == direction::upload)) {
 				out += Mv::to(y+1, x + 1);
 			} else {
 				out += Mv::to(y + u_graph_height + 1 + ((height * swap_upload_download) % 2), x + 1);
 			}
-			out += graphs.at(dir)(safeVal(net.bandwidth, dir), redraw or data_same or not net.connected)
-				+ Mv::to(y+1 + (((dir == "upload") == (!swap_upload_download)) * (height - 3)), x + 1) + Fx::ub + Theme::c("graph_text")
-				+ floating_humanizer((dir == "upload" ? up_max : down_max), true);
-			const string speed = floating_humanizer(safeVal(net.stat, dir).speed, false, 0, false, true);
-			const string speed_bits = (b_width >= 20 ? floating_humanizer(safeVal(net.stat, dir).speed, false, 0, true, true) : "");
-			const string top = floating_humanizer(safeVal(net.stat, dir).top, false, 0, true, true);
-			const string total = floating_humanizer(safeVal(net.stat, dir).total);
-			const string symbol = (dir == "upload" ? "▲" : "▼");
-			if ((swap_upload_download and dir == "upload") or (not swap_upload_download and dir == "download")) {
+			out += graphs[dir](net.bandwidth[dir], redraw or data_same or not net.connected)
+				+ Mv::to(y+1 + (((dir == direction::upload) == (!swap_upload_download)) * (height - 3)), x + 1) + Fx::ub + Theme::c("graph_text")
+				+ floating_humanizer((dir == direction::upload ? up_max : down_max), true);
+			const string speed = floating_humanizer(stat.speed, false, 0, false, true);
+			const string speed_bits = (b_width >= 20 ? floating_humanizer(stat.speed, false, 0, true, true) : "");
+			const string top = floating_humanizer(stat.top, false, 0, true, true);
+			const string total = floating_humanizer(stat.total);
+			const string symbol = (dir == direction::upload ? "▲" : "▼");
+			if ((swap_upload_download and dir == direction::upload) or (not swap_upload_download and dir == direction::download)) {
 				// Top graph
 				out += Mv::to(b_y+1, b_x+1) + Fx::ub + Theme::c("main_fg") + symbol + ' ' + ljust(speed, 10) + (b_width >= 20 ? rjust('(' + speed_bits + ')', 13) : "");
 				if (b_height >= 8)
@@ -1559,8 +1586,18 @@ namespace Proc {
 	Draw::TextEdit filter;
 	Draw::Graph detailed_cpu_graph;
 	Draw::Graph detailed_mem_graph;
+	Draw::Graph detailed_fault_graph;
+	Draw::Graph detailed_wait_graph;
+	Draw::Graph detailed_pss_graph;
+	Draw::Graph detailed_uss_graph;
 	int user_size, thread_size, prog_size, cmd_size, tree_size;
+	vector<string> extra_columns;
+	const std::unordered_map<string, string> proc_column_names = {
+		{"io_read", "Read"}, {"io_write", "Write"}, {"fds", "Fds"}, {"wait", "Wait%"},
+		{"minflt", "MinF"}, {"majflt", "MajF"}, {"ctx_vol", "VCsw"}, {"ctx_invol", "ICsw"}
+	};
 	int dgraph_x, dgraph_width, d_width, d_x, d_y;
+	int smaps_graph_width; // width of each of the PSS and USS graphs in the detailed box, 0 if not shown
 	bool previous_proc_banner_state = false;
 	atomic<bool> resized (false);
 
@@ -1646,9 +1683,118 @@ namespace Proc {
 		return (not changed ? -1 : selected);
 	}
 
+	//* Draw the cgroup view, one line per cgroup in place of the process list
+	static string draw_cgroups(bool force_redraw) {
+		const auto& sorting = Config::getS("proc_sorting");
+		start = Config::getI("proc_start");
+		selected = Config::getI("proc_selected");
+		const int select_max = Proc::select_max;
+		const int numpids = Proc::numpids;
+		Config::set("proc_banner_shown", false);
+		selected_pid = 0;
+		if (force_redraw) redraw = true;
+		string out;
+		out.reserve(width * height);
+
+		//? Io columns are dropped if the path would get narrower than 10
+		const bool show_io = width - 33 >= 10;
+		const int path_size = width - 3 - (show_io ? 30 : 18);
+
+		if (redraw) {
+			out = box;
+			const string title_left = Theme::c("proc_box") + Symbols::title_left;
+			const string title_right = Theme::c("proc_box") + Symbols::title_right;
+			const string title_left_down = Theme::c("proc_box") + Symbols::title_left_down;
+			const string title_right_down = Theme::c("proc_box") + Symbols::title_right_down;
+			for (const auto& key : {"t", "K", "k", "s", "N", "F", "u", "c", "e", "enter", "info_enter"})
+				if (Input::mouse_mappings.contains(key)) Input::mouse_mappings.erase(key);
+
+			out += Mv::to(y, x + 9) + title_left + Fx::b + Theme::c("title") + "cgroup " + Theme::c("hi_fg") + 'v'
+				+ Theme::c("title") + "iew" + Fx::ub + title_right;
+			Input::mouse_mappings["v"] = {y, x + 10, 1, 11};
+
+			const int sort_len = sorting.size();
+			const int sort_pos = x + width - sort_len - 8;
+			if (width > 45 + sort_len) {
+				out += Mv::to(y, sort_pos - 15) + title_left + (Config::getB("proc_reversed") ? Fx::b : "") + Theme::c("hi_fg")
+					+ 'r' + Theme::c("title") + "everse" + Fx::ub + title_right;
+				Input::mouse_mappings["r"] = {y, sort_pos - 14, 1, 7};
+			}
+			out += Mv::to(y, sort_pos) + title_left + Fx::b + Theme::c("hi_fg") + Symbols::left + " " + Theme::c("title") + sorting + " " + Theme::c("hi_fg")
+				+ Symbols::right + Fx::ub + title_right;
+			Input::mouse_mappings["left"] = {y, sort_pos + 1, 1, 2};
+			Input::mouse_mappings["right"] = {y, sort_pos + sort_len + 3, 1, 2};
+
+			const string t_color = (selected == 0 ? Theme::c("inactive_fg") : Theme::c("title"));
+			const string hi_color = (selected == 0 ? Theme::c("inactive_fg") : Theme::c("hi_fg"));
+			out += Mv::to(y + height - 1, x + 1) + title_left_down + Fx::b + Theme::c("hi_fg") + Symbols::up + Theme::c("title") + " select "
+				+ Theme::c("hi_fg") + Symbols::down + Fx::ub + title_right_down
+				+ title_left_down + Fx::b + t_color + "processes " + hi_color + Symbols::enter + Fx::ub + title_right_down;
+			if (selected > 0) Input::mouse_mappings["enter"] = {y + height - 1, x + 14, 1, 11};
+
+			out += Mv::to(y + 1, x + 1) + Theme::c("title") + Fx::b + ljust("Cgroup:", path_size) + ' '
+				+ rjust("Cpu%", 5) + ' ' + rjust("Mem", 5) + ' '
+				+ (show_io ? rjust("Read", 5) + ' ' + rjust("Write", 5) + ' ' : "")
+				+ rjust("Thr%", 5) + Fx::ub;
+		}
+
+		//? Check bounds of current selection and view
+		if (start > 0 and numpids <= select_max)
+			start = 0;
+		if (start > numpids - select_max)
+			start = max(0, numpids - select_max);
+		if (selected > select_max)
+			selected = select_max;
+		if (selected > numpids)
+			selected = numpids;
+
+		auto percent = [](double value) { return fmt::format("{:.{}f}", value, (value < 100 ? 1 : 0)); };
+		int lc = 0;
+		for (int n = start; n < (int)cgroups.size() and lc < select_max; n++, lc++) {
+			const auto& cgroup = cgroups[n];
+			const bool is_selected = (lc + 1 == selected);
+			out += Fx::reset + Mv::to(y + 2 + lc, x + 1)
+				+ (is_selected ? Theme::c("selected_bg") + Theme::c("selected_fg") + Fx::b : Theme::c("main_fg"))
+				+ ljust(cgroup.path, path_size, true) + ' '
+				+ rjust(percent(cgroup.cpu_p), 5) + ' '
+				+ rjust(floating_humanizer(cgroup.mem, true), 5) + ' ';
+			if (show_io) {
+				out += rjust((cgroup.io_read_rate >= 0 ? floating_humanizer(cgroup.io_read_rate, true) : ""), 5) + ' '
+					+ rjust((cgroup.io_write_rate >= 0 ? floating_humanizer(cgroup.io_write_rate, true) : ""), 5) + ' ';
+			}
+			out += rjust((cgroup.nr_throttled > 0 ? percent(cgroup.throttled_p) : ""), 5) + ' ';
+		}
+
+		out += Fx::reset;
+		while (lc++ < height - 3) out += Mv::to(y + lc + 1, x + 1) + string(width - 2, ' ');
+
+		//? Draw scrollbar if needed
+		if (numpids > select_max) {
+			scroll_pos = clamp((int)round((double)start * select_max / (numpids - select_max)), 0, height - 5);
+			out += Mv::to(y + 1, x + width - 2) + Fx::b + Theme::c("main_fg") + Symbols::up
+				+ Mv::to(y + height - 2, x + width - 2) + Symbols::down;
+
+			for (int i = y + 2; i < y + height - 2; i++) {
+				out += Mv::to(i, x + width - 2) + ((i == y + 2 + scroll_pos) ? "█" : " ");
+			}
+		}
+
+		//? Current selection and number of cgroups
+		string location = to_string(start + selected) + '/' + to_string(numpids);
+		string loc_clear = Symbols::h_line * max((size_t)0, 9 - location.size());
+		out += Mv::to(y + height - 1, x+width - 3 - max(9, (int)location.size())) + Fx::ub + Theme::c("proc_box") + loc_clear
+			+ Symbols::title_left_down + Theme::c("title") + Fx::b + location + Fx::ub + Theme::c("proc_box") + Symbols::title_right_down;
+
+		redraw = false;
+		return out + Fx::reset;
+	}
+
 	string draw(const vector<proc_info>& plist, bool force_redraw, bool data_same) {
 		if (Runner::stopping) return "";
-		auto proc_tree = Config::getB("proc_tree");
+		if (Config::getB("proc_cgroup_view")) return draw_cgroups(force_redraw);
+		//? The program view has one row per program name and is never drawn as a tree
+		const bool aggregate = Config::getB("proc_group_programs");
+		auto proc_tree = Config::getB("proc_tree") and not aggregate;
 		bool show_detailed = (Config::getB("show_detailed") and cmp_equal(Proc::detailed.last_pid, Config::getI("detailed_pid")));
 		bool proc_gradient = (Config::getB("proc_gradient") and not Config::getB("lowcolor") and Theme::gradients.contains("proc"));
 		auto proc_colors = Config::getB("proc_colors");
@@ -1756,6 +1902,15 @@ namespace Proc {
 				tree_size += 5;
 			}
 
+			//? Optional columns from proc_columns take 6 characters each, the last ones are dropped if the command or tree gets too narrow
+			extra_columns = ssplit(Config::getS("proc_columns"));
+			if (Config::getS("proc_sorting") == "top waiters" and not v_contains(extra_columns, "wait"))
+				extra_columns.insert(extra_columns.begin(), "wait");
+			while (not extra_columns.empty() and (proc_tree ? tree_size : cmd_size) - 6 * (int)extra_columns.size() < 10)
+				extra_columns.pop_back();
+			cmd_size -= 6 * extra_columns.size();
+			tree_size -= 6 * extra_columns.size();
+
 			//? Detailed box
 			if (show_detailed) {
 				bool alive = detailed.status != "Dead";
@@ -1767,8 +1922,21 @@ namespace Proc {
 
 				//? Create cpu and mem graphs if process is alive
 				if (alive or pause_proc_list) {
-					detailed_cpu_graph = Draw::Graph{dgraph_width - 1, 7, "cpu", detailed.cpu_percent, graph_symbol, false, true};
+					//? The bottom two lines of the cpu graph are used for the run queue wait graph when available
+					const int wait_height = (detailed.wait_percent.empty() ? 0 : 2);
+					detailed_cpu_graph = Draw::Graph{dgraph_width - 1, 7 - wait_height, "cpu", detailed.cpu_percent, graph_symbol, false, true};
+					if (wait_height > 0)
+						detailed_wait_graph = Draw::Graph{dgraph_width - 1, wait_height, "used", detailed.wait_percent, graph_symbol, false, true};
 					detailed_mem_graph = Draw::Graph{d_width / 3, 1, "", detailed.mem_bytes, graph_symbol, false, false, detailed.first_mem};
+					detailed_fault_graph = Draw::Graph{d_width / 3, 1, "", detailed.fault_rate, graph_symbol, false, false, detailed.fault_max};
+				}
+
+				//? PSS and USS graphs share the first command line row, scaled like the memory graph
+				smaps_graph_width = (detailed.pss_bytes.empty() ? 0 : (d_width - 2) / 2 - 13);
+				if (smaps_graph_width < 3) smaps_graph_width = 0;
+				if (smaps_graph_width > 0 and (alive or pause_proc_list)) {
+					detailed_pss_graph = Draw::Graph{smaps_graph_width, 1, "", detailed.pss_bytes, graph_symbol, false, false, detailed.first_mem};
+					detailed_uss_graph = Draw::Graph{smaps_graph_width, 1, "", detailed.uss_bytes, graph_symbol, false, false, detailed.first_mem};
 				}
 
 				//? Draw structure of details box
@@ -1824,15 +1992,23 @@ namespace Proc {
 				if (item_fit >= 8) out += cjust("Nice:", item_width);
 
 
-				//? Command line
-				for (int i = 0; const auto& l : {'C', 'M', 'D'})
-				out += Mv::to(d_y + 5 + i++, d_x + 1) + l;
+				//? Command line, two lines below the PSS and USS graphs when shown
+				if (smaps_graph_width == 0) {
+					for (int i = 0; const auto& l : {'C', 'M', 'D'})
+					out += Mv::to(d_y + 5 + i++, d_x + 1) + l;
+				}
+				else {
+					for (int i = 0; const auto& l : {"Pss:", "Uss:"})
+						out += Mv::to(d_y + 5, d_x + 1 + (d_width - 2) / 2 * i++) + l;
+				}
 
 				out += Theme::c("main_fg") + Fx::ub;
 				const auto san_cmd = replace_ascii_control(detailed.entry.cmd);
 				const int cmd_size = ulen(san_cmd, true);
-				for (int num_lines = min(3, (int)ceil((double)cmd_size / (d_width - 5))), i = 0; i < num_lines; i++) {
-					out += Mv::to(d_y + 5 + (num_lines == 1 ? 1 : i), d_x + 3)
+				const int cmd_y = d_y + (smaps_graph_width == 0 ? 5 : 6);
+				const int cmd_lines = (smaps_graph_width == 0 ? 3 : 2);
+				for (int num_lines = min(cmd_lines, (int)ceil((double)cmd_size / (d_width - 5))), i = 0; i < num_lines; i++) {
+					out += Mv::to(cmd_y + (num_lines == 1 and cmd_lines == 3 ? 1 : i), d_x + 3)
 						+ cjust(luresize(san_cmd, cmd_size - (d_width - 5) * i, true), d_width - 5, true, true);
 				}
 
@@ -1859,6 +2035,22 @@ namespace Proc {
 			const int sort_len = sorting.size();
 			const int sort_pos = x + width - sort_len - 8;
 
+		#ifdef __linux__
+			//? Cgroup entered from the cgroup view, after the filter if there is room left of the toggles, keeping the end of the path
+			if (const auto& scope = Config::getS("proc_cgroup_scope"); not scope.empty()) {
+				const int scope_x = x + 9 + 3 + (filter_text.empty() ? 5 : ulen(filter_text) + 1)
+					+ (not filtering and not filter_text.empty() ? 4 : 0) + (filtering ? 2 : 0);
+				const int toggles_x = (width > 60 + sort_len ? sort_pos - 32 : width > 55 + sort_len ? sort_pos - 25
+					: width > 45 + sort_len ? sort_pos - 15 : width > 35 + sort_len ? sort_pos - 6 : sort_pos);
+				const int scope_len = toggles_x - scope_x - 14;
+				if (scope_len >= 4) {
+					out += Mv::to(y, scope_x) + title_left + Fx::b + Theme::c("title") + "cgroup " + Fx::ub + Theme::c("main_fg")
+						+ ((int)scope.size() > scope_len ? scope.substr(scope.size() - scope_len) : scope)
+						+ Theme::c("hi_fg") + " esc" + title_right;
+				}
+			}
+		#endif
+
 			if (width > 60 + sort_len) {
 			    fmt::format_to(std::back_inserter(out), "{}{}{}{}{}{}{}{}{}{}{}",
 					Mv::to(y, sort_pos - 32), title_left, pause_proc_list ? Fx::b : "",
@@ -1924,7 +2116,7 @@ namespace Proc {
 			//? Labels for fields in list
 			if (not proc_tree)
 				out += Mv::to(y+1, x+1) + Theme::c("title") + Fx::b
-					+ rjust("Pid:", 8) + ' '
+					+ rjust((aggregate ? "Count:" : "Pid:"), 8) + ' '
 					+ ljust("Program:", prog_size) + ' '
 					+ (cmd_size > 0 ? ljust("Command:", cmd_size) : "") + ' ';
 			else
@@ -1932,8 +2124,10 @@ namespace Proc {
 					+ ljust("Tree:", tree_size) + ' ';
 
 			out += (thread_size > 0 ? Mv::l(4) + "Threads: " : "")
-					+ ljust("User:", user_size) + ' '
-					+ rjust((mem_bytes ? "MemB" : "Mem%"), 5) + ' '
+					+ ljust("User:", user_size) + ' ';
+			for (const auto& column : extra_columns)
+				out += rjust(proc_column_names.at(column), 5) + ' ';
+			out += rjust((mem_bytes ? "MemB" : "Mem%"), 5) + ' '
 					+ rjust("Cpu%", (show_graphs ? 10 : 5)) + Fx::ub;
 		}
 		//* End of redraw block
@@ -1954,6 +2148,10 @@ namespace Proc {
 				+ Mv::to(d_y + 1, dgraph_x + 1) + Theme::c("title") + Fx::b + rjust(cpu_str, 4) + "%";
 			for (int i = 0; const auto& l : {'C', 'P', 'U'})
 					out += Mv::to(d_y + 3 + i++, dgraph_x + 1) + l;
+			if (not detailed.wait_percent.empty()) {
+				out += Mv::to(d_y + 6, dgraph_x + 1) + Fx::ub + detailed_wait_graph(detailed.wait_percent, (redraw or data_same or not alive))
+					+ Mv::to(d_y + 6, dgraph_x + 1) + Theme::c("title") + Fx::b + "Wait " + to_string(detailed.wait_percent.back()) + '%';
+			}
 
 			//? Info part of box
 			const string stat_color = (not alive ? Theme::c("inactive_fg") : (detailed.status == "Running" ? Theme::c("proc_misc") : Theme::c("main_fg")));
@@ -1968,6 +2166,12 @@ namespace Proc {
 			if (item_fit >= 8) out += cjust(to_string(detailed.entry.p_nice), item_width);
 
 
+			//? Page faults per second
+			out += Mv::to(d_y + 3, d_x + 1) + Theme::c("title") + Fx::b + rjust((item_fit > 4 ? "Faults: " : "F: "), (d_width / 3) - 2)
+				+ Theme::c("inactive_fg") + Fx::ub + graph_bg * (d_width / 3) + Mv::l(d_width / 3)
+				+ Theme::c("proc_misc") + detailed_fault_graph(detailed.fault_rate, (redraw or data_same or not alive)) + ' '
+				+ Theme::c("main_fg") + ljust(detailed.faults, max(0, d_width - (d_width / 3) * 2 - 2));
+
 			const double mem_p = detailed.mem_bytes.back() * 100.0 / totalMem;
 			string mem_str = fmt::format("{:.2f}", mem_p);
 			mem_str.resize(4);
@@ -1976,6 +2180,18 @@ namespace Proc {
 				+ Theme::c("inactive_fg") + Fx::ub + graph_bg * (d_width / 3) + Mv::l(d_width / 3)
 				+ Theme::c("proc_misc") + detailed_mem_graph(detailed.mem_bytes, (redraw or data_same or not alive)) + ' '
 				+ Theme::c("title") + Fx::b + detailed.memory;
+			//? Swap and huge pages after the memory value if there is room left on the line
+			if (const int detail_width = d_width - (d_width / 3) * 2 - 2 - (int)ulen(detailed.memory); not detailed.mem_detail.empty() and detail_width >= 10)
+				out += ' ' + Theme::c("main_fg") + Fx::ub + uresize(detailed.mem_detail, detail_width);
+
+			//? PSS and USS graphs with their current values
+			if (smaps_graph_width > 0 and not detailed.pss_bytes.empty()) {
+				for (int i = 0; const auto& [graph, series] : {std::pair{&detailed_pss_graph, &detailed.pss_bytes}, {&detailed_uss_graph, &detailed.uss_bytes}}) {
+					out += Mv::to(d_y + 5, d_x + 6 + (d_width - 2) / 2 * i++) + Theme::c("inactive_fg") + Fx::ub + graph_bg * smaps_graph_width + Mv::l(smaps_graph_width)
+						+ Theme::c("proc_misc") + (*graph)(*series, (redraw or data_same or not alive)) + ' '
+						+ Theme::c("main_fg") + ljust(floating_humanizer(series->back(), true), 6);
+				}
+			}
 		}
 
 		//? Check bounds of current selection and view
@@ -2057,13 +2273,13 @@ namespace Proc {
 			//? Normal view line
 			if (not proc_tree) {
 				out += Mv::to(y+2+lc, x+1)
-					+ g_color + rjust(to_string(p.pid), 8) + ' '
+					+ g_color + rjust(to_string(p.group_count > 0 ? p.group_count : p.pid), 8) + ' '
 					+ c_color + ljust(p.name, prog_size, true) + ' ' + end
 					+ (cmd_size > 0 ? g_color + ljust(san_cmd, cmd_size, true, p_wide_cmd[p.pid]) + Mv::to(y+2+lc, x+11+prog_size+cmd_size) + ' ' : "");
 			}
 			//? Tree view line
 			else {
-				const string prefix_pid = p.prefix + to_string(p.pid);
+				const string prefix_pid = tree_prefix(p) + to_string(p.pid);
 				int width_left = tree_size;
 				out += Mv::to(y+2+lc, x+1) + g_color + uresize(prefix_pid, width_left) + ' ';
 				width_left -= ulen(prefix_pid);
@@ -2108,8 +2324,20 @@ namespace Proc {
 			}();
 
 			out += (thread_size > 0 ? t_color + rjust(proc_threads_string, thread_size) + ' ' + end : "" )
-				+ g_color + ljust((cmp_greater(p.user.size(), user_size) ? p.user.substr(0, user_size - 1) + '+' : p.user), user_size) + ' '
-				+ m_color + rjust(mem_str, 5) + end + ' '
+				+ g_color + ljust((cmp_greater(p.user.size(), user_size) ? p.user.substr(0, user_size - 1) + '+' : p.user.get()), user_size) + ' ';
+			for (const auto& column : extra_columns) {
+				string value;
+				if (column == "io_read" and p.io_read_rate >= 0) value = floating_humanizer(p.io_read_rate, true);
+				else if (column == "io_write" and p.io_write_rate >= 0) value = floating_humanizer(p.io_write_rate, true);
+				else if (column == "fds" and p.fds >= 0) value = to_string(p.fds);
+				else if (column == "wait" and p.wait_p >= 0) value = fmt::format("{:.{}f}", p.wait_p, (p.wait_p < 10 ? 1 : 0));
+				else if (column == "minflt") value = count_humanizer(p.minflt_rate);
+				else if (column == "majflt") value = count_humanizer(p.majflt_rate);
+				else if (column == "ctx_vol" and p.vctx_rate >= 0) value = count_humanizer(p.vctx_rate);
+				else if (column == "ctx_invol" and p.nvctx_rate >= 0) value = count_humanizer(p.nvctx_rate);
+				out += rjust(value, 5) + ' ';
+			}
+			out += m_color + rjust(mem_str, 5) + end + ' '
 				+ (is_selected or is_followed ? "" : Theme::c("inactive_fg")) + (show_graphs ? graph_bg * 5: "")
 				+ (p_graphs.contains(p.pid) ? Mv::l(5) + c_color + p_graphs.at(p.pid)({(p.cpu_p >= 0.1 and p.cpu_p < 5 ? 5ll : (long long)round(p.cpu_p))}, data_same) : "") + end + ' '
 				+ c_color + rjust(cpu_str, 4) + "  " + end;
@@ -2259,6 +2487,7 @@ namespace Draw {
 				: 0;
 		#endif
             const bool show_temp = (Config::getB("check_temp") and got_sensors);
+			const int freq_width = (Config::getB("show_core_freq") and has_core_freq ? 5 : 0);
 			width = round((double)Term::width * width_p / 100);
 		#ifdef GPU_SUPPORT
 			if (Gpu::shown != 0 and not (Mem::shown or Net::shown or Proc::shown)) {
@@ -2278,23 +2507,23 @@ namespace Draw {
 		#else
 			b_columns = max(1, (int)ceil((double)(Shared::coreCount + 1) / (height - 5)));
 		#endif
-			if (b_columns * (21 + 12 * show_temp) < width - (width / 3)) {
+			if (b_columns * (21 + 12 * show_temp + freq_width) < width - (width / 3)) {
 				b_column_size = 2;
-				b_width =  max(29, (21 + 12 * show_temp) * b_columns - (b_columns - 1));
+				b_width =  max(29, (21 + 12 * show_temp + freq_width) * b_columns - (b_columns - 1));
 			}
-			else if (b_columns * (15 + 6 * show_temp) < width - (width / 3)) {
+			else if (b_columns * (15 + 6 * show_temp + freq_width) < width - (width / 3)) {
 				b_column_size = 1;
-				b_width = (15 + 6 * show_temp) * b_columns - (b_columns - 1);
+				b_width = (15 + 6 * show_temp + freq_width) * b_columns - (b_columns - 1);
 			}
-			else if (b_columns * (8 + 6 * show_temp) < width - (width / 3)) {
+			else if (b_columns * (8 + 6 * show_temp + freq_width) < width - (width / 3)) {
 				b_column_size = 0;
 			}
 			else {
-				b_columns = (width - width / 3) / (8 + 6 * show_temp);
+				b_columns = (width - width / 3) / (8 + 6 * show_temp + freq_width);
 				b_column_size = 0;
 			}
 
-			if (b_column_size == 0) b_width = (8 + 6 * show_temp) * b_columns + 1;
+			if (b_column_size == 0) b_width = (8 + 6 * show_temp + freq_width) * b_columns + 1;
 		#ifdef GPU_SUPPORT
 			//gpus_extra_height = max(0, gpus_extra_height - 1);
 			b_height = min(height - 2, (int)ceil((double)Shared::coreCount / b_columns) + 4 + gpus_extra_height);
@@ -224,6 +224,12 @@ namespace Input {
 				if (key == "q") {
 					clean_quit(0);
 				}
+			#ifdef __linux__
+				//? Escape goes back to the cgroup view from a cgroup entered with enter, instead of opening the menu
+				else if (key == "escape" and Proc::shown and not Config::getS("proc_cgroup_scope").empty()) {
+					keep_going = true;
+				}
+			#endif
 				else if (is_in(key, "escape", "m")) {
 					Menu::show(Menu::Menus::Main);
 					return;
@@ -317,6 +323,64 @@ namespace Input {
 					else
 						return;
 				}
+			#ifdef __linux__
+				else if (is_in(key, "v", "escape")) {
+					if (key == "escape")
+						Config::set("proc_cgroup_view", true);
+					else
+						Config::flip("proc_cgroup_view");
+					Config::set("proc_cgroup_scope", ""s);
+					Config::set("proc_start", 0);
+					Config::set("proc_selected", 0);
+					Config::set("proc_last_selected", 0);
+					if (Config::getB("proc_cgroup_view")) {
+						Config::set("show_detailed", false);
+						Config::set("detailed_pid", 0);
+						Config::set("follow_process", false);
+						Config::set("followed_pid", 0);
+						Config::set("proc_followed", 0);
+					}
+					no_update = false;
+				}
+				//? Enter shows the processes of the selected cgroup until escape or "v" is pressed, process actions are not available in the cgroup view
+				else if (Config::getB("proc_cgroup_view") and is_in(key, "enter", "info_enter")) {
+					if (Config::getI("proc_selected") == 0) return;
+					atomic_wait(Runner::active);
+					const size_t index = Config::getI("proc_start") + Config::getI("proc_selected") - 1;
+					if (index >= Proc::cgroups.size()) return;
+					Config::set("proc_cgroup_scope", Proc::cgroups.at(index).path);
+					Config::set("proc_cgroup_view", false);
+					Config::set("proc_start", 0);
+					Config::set("proc_selected", 0);
+					no_update = false;
+				}
+				else if (Config::getB("proc_cgroup_view") and is_in(key, "e", "u", "F", "%", "+", "-", "space", "C", "t", kill_key, "s", "N"))
+					return;
+			#endif
+				else if (key == "A") {
+					Config::flip("proc_group_programs");
+					Config::set("proc_start", 0);
+					Config::set("proc_selected", 0);
+					Config::set("proc_last_selected", 0);
+					if (Config::getB("proc_group_programs")) {
+						Config::set("show_detailed", false);
+						Config::set("detailed_pid", 0);
+						Config::set("follow_process", false);
+						Config::set("followed_pid", 0);
+						Config::set("proc_followed", 0);
+					}
+				}
+				//? Enter on a program row shows its processes by filtering on the program name, process actions are not available in the program view
+				else if (Config::getB("proc_group_programs") and is_in(key, "enter", "info_enter")) {
+					if (Config::getI("proc_selected") == 0) return;
+					atomic_wait(Runner::active);
+					Config::set("proc_filter", Proc::selected_name);
+					Config::set("proc_group_programs", false);
+					Config::set("proc_start", 0);
+					Config::set("proc_selected", 0);
+				}
+				else if (Config::getB("proc_group_programs") and is_in(key, "e", "F", "+", "-", "space", "C", "t", kill_key, "s", "N"))
+					return;
 				else if (key == "left" or (vim_keys and key == "h")) {
 					int cur_i = v_index(Proc::sort_vector, Config::getS("proc_sorting"));
 					if (--cur_i < 0)
@@ -206,6 +206,9 @@ namespace Menu {
 		{"r", "Reverse sorting order in processes box."},
 		{"e", "Toggle processes tree view."},
 		{"%", "Toggles memory display mode in processes box."},
+		{"v", "Toggle cgroup view in processes box (Linux)."},
+		{"Esc", "Return to cgroup view from an entered cgroup."},
+		{"A", "Toggle program view, one row per program name."},
 		{"Selected +, -", "Expand/collapse the selected process in tree view."},
 		{"Selected t", "Terminate selected process with SIGTERM - 15."},
 		{"Selected k", "Kill selected process with SIGKILL - 9."},
@@ -540,6 +543,15 @@ namespace Menu {
 				"Highest, the highest frequency.",
 				"",
 				"Average, sum and divide."},
+			{"show_core_freq",
+				"Show the frequency of each core.",
+				"",
+				"Shown in GHz next to the core usage and",
+				"colored by its share of the maximum",
+				"frequency of the core, so cores that are",
+				"throttled stand out.",
+				"",
+				"True or False."},
 		#endif
 			{"custom_cpu_name",
 				"Custom cpu model name in cpu percentage box.",
@@ -806,12 +818,16 @@ namespace Menu {
 				"",
 				"Possible values:",
 				"\"pid\", \"program\", \"arguments\", \"threads\",",
-				"\"user\", \"memory\", \"cpu lazy\" and",
-				"\"cpu direct\".",
+				"\"user\", \"memory\", \"cpu lazy\",",
+				"\"cpu direct\", \"minor faults\",",
+				"\"major faults\" and \"top waiters\" (Linux).",
 				"",
 				"\"cpu lazy\" updates top process over time.",
 				"\"cpu direct\" updates top process",
-				"directly."},
+				"directly.",
+				"\"top waiters\" sorts by time spent waiting",
+				"for a cpu, read for all processes every",
+				"5 updates."},
 			{"proc_reversed",
 				"Reverse processes sorting order.",
 				"",
@@ -827,6 +843,14 @@ namespace Menu {
 				"",
 				"In tree-view, include all child resources",
 				"with the parent even while expanded."},
+			{"proc_group_programs",
+				"Group processes by program name.",
+				"",
+				"Show one row per program name with the",
+				"number of processes and their summed cpu,",
+				"memory and threads.",
+				"",
+				"Toggle with \"A\" in the process box."},
 			{"proc_colors",
 				"Enable colors in process view.",
 				"",
@@ -866,6 +890,82 @@ namespace Menu {
 				"",
 				"Set to 'True' to filter out internal",
 				"processes started by the Linux kernel."},
+			{"proc_collect_threads",
+				"(Linux) Threads used to read /proc.",
+				"",
+				"Splits reading of process information",
+				"between this many threads.",
+				"",
+				"Can lower collection time on systems",
+				"with many cores and processes.",
+				"",
+				"Min value: 1 (no worker threads)",
+				"Max value: 64"},
+			{"proc_events",
+				"(Linux) Track processes with events.",
+				"",
+				"Keep the process list updated from kernel",
+				"fork, exec and exit events instead of",
+				"scanning /proc every update.",
+				"",
+				"Also shows processes that started and",
+				"exited between two updates.",
+				"",
+				"Needs root or CAP_NET_ADMIN, falls back",
+				"to scanning /proc if not available."},
+			{"proc_idle_refresh",
+				"(Linux) Update interval for idle processes.",
+				"",
+				"Processes that used no cpu time when",
+				"last read are only read every N updates,",
+				"processes using cpu are read every update.",
+				"",
+				"Lowers collection time on hosts with",
+				"many long running idle processes.",
+				"",
+				"Min value: 1 (read all every update)",
+				"Max value: 100"},
+			{"proc_cmd_refresh",
+				"(Linux) Command line refresh interval.",
+				"",
+				"Re-read name, command line and user of",
+				"running processes every N updates.",
+				"",
+				"They are always read for new processes",
+				"and when a pid is reused, and after exec()",
+				"if 'proc_events' is enabled.",
+				"",
+				"Min value: 0 (never re-read)",
+				"Max value: 10000"},
+			{"proc_columns",
+				"(Linux) Extra columns in the process list.",
+				"",
+				"Only read for processes in or near the",
+				"visible part of the list.",
+				"",
+				"\"io_read\" \"io_write\": disk bytes per second",
+				"\"fds\": open file descriptors",
+				"\"wait\": % of time waiting for a cpu",
+				"\"minflt\" \"majflt\": page faults per second",
+				"\"ctx_vol\" \"ctx_invol\": voluntary and",
+				"involuntary context switches per second",
+				"",
+				"Separate values with whitespace."},
+			{"proc_cgroup",
+				"(Linux) Only show processes in a cgroup.",
+				"",
+				"Path of a cgroup v2 relative to the",
+				"cgroup2 mount point, processes in the",
+				"cgroups below it are also shown.",
+				"e.g. \"/system.slice/nginx.service\"",
+				"",
+				"Only the pids of the cgroup are read",
+				"instead of all pids in /proc.",
+				"",
+				"Cpu and mem boxes show the usage of",
+				"the cgroup.",
+				"",
+				"Empty string to disable."},
 			{"proc_follow_detailed",
 				"Follow selected process with detailed view",
 				"",
@@ -984,7 +1084,7 @@ namespace Menu {
 			y = Term::height/2 - 9;
 			bg = Draw::createBox(x + 2, y, 78, 19, Theme::c("hi_fg"), true, "signals");
 			bg += Mv::to(y+2, x+3) + Theme::c("title") + Fx::b + cjust("Send signal to PID " + to_string(s_pid) + " ("
-				+ uresize((s_pid == Config::getI("detailed_pid") ? Proc::detailed.entry.name : Config::getS("selected_name")), 30) + ")", 76);
+				+ uresize((s_pid == Config::getI("detailed_pid") ? Proc::detailed.entry.name.get() : Config::getS("selected_name")), 30) + ")", 76);
 		}
 		else if (is_in(key, "escape", "q")) {
 			return Closed;
@@ -1104,7 +1204,7 @@ namespace Menu {
 		if (s_pid == 0) return Closed;
 		if (redraw) {
 			atomic_wait(Runner::active);
-			auto& p_name = (s_pid == Config::getI("detailed_pid") ? Proc::detailed.entry.name : Config::getS("selected_name"));
+			auto& p_name = (s_pid == Config::getI("detailed_pid") ? Proc::detailed.entry.name.get() : Config::getS("selected_name"));
 			vector<string> cont_vec = {
 				Fx::b + Theme::c("main_fg") + "Send signal: " + Fx::ub + Theme::c("hi_fg") + to_string(signalToSend)
 				+ (signalToSend > 0 and signalToSend <= 32 ? Theme::c("main_fg") + " (" + P_Signals.at(signalToSend) + ')' : ""),
@@ -1340,7 +1440,7 @@ static int optionsMenu(const string& key) {
 				const auto& option = categories[selected_cat][item_height * page + selected][0];
 				if (selPred.test(isString) and Config::stringValid(option, editor.text)) {
 					Config::set(option, editor.text);
-					if (option == "custom_cpu_name" or option.starts_with("custom_gpu_name"))
+					if (option == "custom_cpu_name" or option.starts_with("custom_gpu_name") or is_in(option, "proc_columns", "proc_cgroup"))
 						screen_redraw = true;
 					else if (is_in(option, "shown_boxes", "presets")) {
 						screen_redraw = true;
@@ -1711,7 +1811,7 @@ static int optionsMenu(const string& key) {
 			y = Term::height/2 - 6;
 			bg = Draw::createBox(x + 2, y, 50, 13, Theme::c("hi_fg"), true, "renice");
 			bg += Mv::to(y+2, x+3) + Theme::c("title") + Fx::b + cjust("Renice PID " + to_string(s_pid) + " ("
-				+ uresize((s_pid == Config::getI("detailed_pid") ? Proc::detailed.entry.name : Config::getS("selected_name")), 15) + ")", 48);
+				+ uresize((s_pid == Config::getI("detailed_pid") ? Proc::detailed.entry.name.get() : Config::getS("selected_name")), 15) + ")", 48);
 		}
 		else if (is_in(key, "escape", "q")) {
 			return Closed;
@@ -17,8 +17,13 @@ tab-size = 4
 */
 
 #include <sys/resource.h>
+#include <algorithm>
+#include <bit>
+#include <cctype>
+#include <charconv>
 #include <filesystem>
 #include <fstream>
+#include <numeric>
 #include <ranges>
 #include <regex>
 #include <string>
@@ -31,8 +36,21 @@ namespace fs = std::filesystem;
 namespace rng = std::ranges;
 using namespace Tools;
 
+namespace Shared {
+	tick_snapshot tick;
+
+#ifndef __linux__
+	void update_tick() {
+		tick.time_us = time_micros();
+		tick.uptime = system_uptime();
+		tick.total_mem = Mem::get_totalMem();
+	}
+#endif
+}
+
 namespace Cpu {
     std::optional<std::string> container_engine;
+	bool has_core_freq{};
 
 	string trim_name(string name) {
 		auto name_vec = ssplit(name);
@@ -83,16 +101,14 @@ namespace Cpu {
 namespace Gpu {
 	vector<string> gpu_names;
 	vector<int> gpu_b_height_offsets;
-	std::unordered_map<string, deque<long long>> shared_gpu_percent = {
-		{"gpu-average", {}},
-		{"gpu-vram-total", {}},
-		{"gpu-pwr-total", {}},
-	};
+	Tools::EnumMap<shared_field, RingBuffer<long long>, shared_field_names> shared_gpu_percent;
 	long long gpu_pwr_total_max = 0;
 }
 #endif
 
 namespace Proc {
+	vector<cgroup_info> cgroups;
+
 bool set_priority(pid_t pid, int priority) {
   if (setpriority(PRIO_PROCESS, pid, priority) == 0) {
     return true;
@@ -100,34 +116,149 @@ bool set_priority(pid_t pid, int priority) {
   return false;
 }
 
-	void proc_sorter(vector<proc_info>& proc_vec, const string& sorting, bool reverse, bool tree) {
-		if (reverse) {
-			switch (v_index(sort_vector, sorting)) {
-			case 0: rng::stable_sort(proc_vec, rng::less{}, &proc_info::pid); 		break;
-			case 1: rng::stable_sort(proc_vec, rng::greater{}, &proc_info::name);		break;
-			case 2: rng::stable_sort(proc_vec, rng::greater{}, &proc_info::cmd); 		break;
-			case 3: rng::stable_sort(proc_vec, rng::less{}, &proc_info::threads);	break;
-			case 4: rng::stable_sort(proc_vec, rng::greater{}, &proc_info::user); 		break;
-			case 5: rng::stable_sort(proc_vec, rng::less{}, &proc_info::mem); 		break;
-			case 6: rng::stable_sort(proc_vec, rng::less{}, &proc_info::cpu_p);		break;
-			case 7: rng::stable_sort(proc_vec, rng::less{}, &proc_info::cpu_c);		break;
+	namespace {
+		//* Position of a process in the list being sorted and its sort key as an unsigned integer
+		//* String columns use their first 8 bytes as key and are only compared in full when those are equal
+		struct sort_entry {
+			uint64_t key;
+			uint32_t index;
+		};
+		vector<sort_entry> sort_entries;
+		vector<uint32_t> sort_pos, sort_at;
+		vector<proc_info> sort_scratch;
+
+		auto string_key(const string& str) -> uint64_t {
+			uint64_t key{};
+			for (size_t i = 0; i < 8; i++)
+				key = (key << 8) | (i < str.size() ? static_cast<unsigned char>(str[i]) : 0);
+			return key;
+		}
+
+		auto double_key(double value) -> uint64_t {
+			if (value == 0.0) value = 0.0;
+			const auto bits = std::bit_cast<uint64_t>(value);
+			return (bits >> 63) ? ~bits : bits | (1ull << 63);
+		}
+
+		auto sort_key_of(const proc_info& p, size_t sort_key) -> uint64_t {
+			switch (sort_key) {
+			case 0: return p.pid;
+			case 1: return string_key(p.name);
+			case 2: return string_key(p.cmd);
+			case 3: return p.threads;
+			case 4: return string_key(p.user);
+			case 5: return p.mem;
+			case 6: return double_key(p.cpu_p);
+			case 7: return double_key(p.cpu_c);
+			case 8: return double_key(p.minflt_rate);
+			case 9: return double_key(p.majflt_rate);
+			case 10: return double_key(p.wait_p);
 			}
+			return 0;
 		}
-		else {
-			switch (v_index(sort_vector, sorting)) {
-			case 0: rng::stable_sort(proc_vec, rng::greater{}, &proc_info::pid); 		break;
-			case 1: rng::stable_sort(proc_vec, rng::less{}, &proc_info::name);		break;
-			case 2: rng::stable_sort(proc_vec, rng::less{}, &proc_info::cmd); 		break;
-			case 3: rng::stable_sort(proc_vec, rng::greater{}, &proc_info::threads);	break;
-			case 4: rng::stable_sort(proc_vec, rng::less{}, &proc_info::user);		break;
-			case 5: rng::stable_sort(proc_vec, rng::greater{}, &proc_info::mem); 		break;
-			case 6: rng::stable_sort(proc_vec, rng::greater{}, &proc_info::cpu_p);   	break;
-			case 7: rng::stable_sort(proc_vec, rng::greater{}, &proc_info::cpu_c);   	break;
+
+		template <size_t SortKey>
+		void fill_keys(vector<uint64_t>& key, const vector<proc_info>& procs) {
+			for (size_t row = 0; const auto& p : procs) key[row++] = sort_key_of(p, SortKey);
+		}
+	}
+
+	void hot_columns::fill(const vector<proc_info>& procs, size_t sort_key) {
+		this->sort_key = sort_key;
+		key.resize(procs.size());
+		//? The key is selected once per fill instead of once per process
+		switch (sort_key) {
+		case 0: fill_keys<0>(key, procs); break;
+		case 1: fill_keys<1>(key, procs); break;
+		case 2: fill_keys<2>(key, procs); break;
+		case 3: fill_keys<3>(key, procs); break;
+		case 4: fill_keys<4>(key, procs); break;
+		case 5: fill_keys<5>(key, procs); break;
+		case 6: fill_keys<6>(key, procs); break;
+		case 7: fill_keys<7>(key, procs); break;
+		case 8: fill_keys<8>(key, procs); break;
+		case 9: fill_keys<9>(key, procs); break;
+		case 10: fill_keys<10>(key, procs); break;
+		default: rng::fill(key, 0);
+		}
+
+		//? Only "cpu lazy" moves processes by their cpu usage
+		cpu_p.clear();
+		if (sort_key < sort_vector.size() and sort_vector[sort_key] == "cpu lazy") {
+			for (const auto& p : procs) cpu_p.push_back(p.cpu_p);
+		}
+	}
+
+	void hot_columns::set(size_t row, const proc_info& proc) {
+		key[row] = sort_key_of(proc, sort_key);
+		if (not cpu_p.empty()) cpu_p[row] = proc.cpu_p;
+	}
+
+	void proc_sorter(vector<proc_info>& proc_vec, const string& sorting, bool reverse, bool tree, size_t sort_count, const hot_columns* columns) {
+		const auto sort_key = v_index(sort_vector, sorting);
+		const bool lazy = not tree and not reverse and sorting == "cpu lazy";
+		//? The "cpu lazy" threshold is taken from the first 7 processes
+		if (lazy and sort_count > 0) sort_count = std::max(sort_count, (size_t)7);
+		if (sort_key < sort_vector.size() and proc_vec.size() > 1) {
+			const bool is_string = (sort_key == 1 or sort_key == 2 or sort_key == 4);
+			auto text = [sort_key](const proc_info& p) -> const string& { return sort_key == 1 ? p.name.get() : sort_key == 2 ? p.cmd : p.user.get(); };
+			//? Strings are sorted ascending and numbers descending unless reversed
+			const bool ascending = is_string != reverse;
+
+			sort_entries.resize(proc_vec.size());
+			if (columns != nullptr and (columns->size() != proc_vec.size() or columns->sort_key != sort_key)) columns = nullptr;
+			for (uint32_t i = 0; auto& entry : sort_entries) {
+				entry.key = (columns != nullptr ? columns->key[i] : sort_key_of(proc_vec[i], sort_key));
+				entry.index = i++;
+			}
+
+			//? Equal keys keep their current order, which gives the same result as a stable sort
+			auto cmp = [&](const sort_entry& a, const sort_entry& b) {
+				if (a.key != b.key) return ascending ? a.key < b.key : b.key < a.key;
+				if (is_string) {
+					if (const int res = text(proc_vec[a.index]).compare(text(proc_vec[b.index])); res != 0)
+						return ascending ? res < 0 : res > 0;
+				}
+				return a.index < b.index;
+			};
+
+			if (sort_count == 0 or sort_count >= sort_entries.size()) {
+				rng::sort(sort_entries, cmp);
+				sort_scratch.clear();
+				sort_scratch.reserve(proc_vec.size());
+				for (const auto& entry : sort_entries) sort_scratch.push_back(std::move(proc_vec[entry.index]));
+				proc_vec.swap(sort_scratch);
+			}
+			//? Only order the first <sort_count> processes, the rest are only moved to make room
+			else {
+				std::nth_element(sort_entries.begin(), sort_entries.begin() + sort_count - 1, sort_entries.end(), cmp);
+
+				//? "cpu lazy" can move processes over 10% cpu from anywhere in the list to the top, those are ordered after the first rows
+				auto head = sort_entries.begin() + sort_count;
+				if (lazy) head = std::partition(head, sort_entries.end(), [&](const sort_entry& entry) { return (columns != nullptr and not columns->cpu_p.empty() ? columns->cpu_p[entry.index] : proc_vec[entry.index].cpu_p) > 10.0; });
+				std::sort(sort_entries.begin(), head, cmp);
+
+				//? Swap the ordered processes into place, <sort_pos> is the current position of each process and <sort_at> the process at each position
+				sort_pos.resize(proc_vec.size());
+				sort_at.resize(proc_vec.size());
+				std::iota(sort_pos.begin(), sort_pos.end(), 0);
+				std::iota(sort_at.begin(), sort_at.end(), 0);
+				for (uint32_t i = 0; i < head - sort_entries.begin(); i++) {
+					const auto index = sort_entries[i].index;
+					const auto from = sort_pos[index];
+					if (from == i) continue;
+					std::swap(proc_vec[i], proc_vec[from]);
+					const auto displaced = sort_at[i];
+					sort_at[from] = displaced;
+					sort_pos[displaced] = from;
+					sort_at[i] = index;
+					sort_pos[index] = i;
+				}
 			}
 		}
 
 		//* When sorting with "cpu lazy" push processes over threshold cpu usage to the front regardless of cumulative usage
-		if (not tree and not reverse and sorting == "cpu lazy") {
+		if (lazy) {
 			double max = 10.0, target = 30.0;
 			for (size_t i = 0, x = 0, offset = 0; i < proc_vec.size(); i++) {
 				if (i <= 5 and proc_vec.at(i).cpu_p > max)
@@ -144,6 +275,48 @@ bool set_priority(pid_t pid, int priority) {
 		}
 	}
 
+	void aggregate(vector<proc_info>& plist, const string& sorting, bool reverse) {
+		//? Names are interned, so equal names share the same c_str() and the pointer is used as key
+		static std::unordered_map<const char*, size_t> group_index;
+		static vector<proc_info> groups;
+		group_index.clear();
+		groups.clear();
+
+		//? Optional column values are -1 if unknown, the sum is unknown only if unknown for all processes
+		auto add_known = [](auto& sum, auto value) {
+			if (value >= 0) sum = (sum < 0 ? value : sum + value);
+		};
+
+		for (auto& p : plist) {
+			if (p.filtered) continue;
+			auto [entry, inserted] = group_index.try_emplace(p.name.c_str(), groups.size());
+			if (inserted) {
+				groups.push_back(std::move(p));
+				groups.back().group_count = 1;
+				continue;
+			}
+			auto& group = groups[entry->second];
+			group.group_count++;
+			group.cpu_p += p.cpu_p;
+			group.cpu_c += p.cpu_c;
+			group.mem += p.mem;
+			group.threads += p.threads;
+			group.minflt_rate += p.minflt_rate;
+			group.majflt_rate += p.majflt_rate;
+			if (group.user != p.user) group.user.clear();
+			add_known(group.io_read_rate, p.io_read_rate);
+			add_known(group.io_write_rate, p.io_write_rate);
+			add_known(group.fds, p.fds);
+			add_known(group.wait_p, p.wait_p);
+			add_known(group.vctx_rate, p.vctx_rate);
+			add_known(group.nvctx_rate, p.nvctx_rate);
+		}
+
+		plist.swap(groups);
+		proc_sorter(plist, sorting, reverse);
+		numpids = plist.size();
+	}
+
 	void tree_sort(vector<tree_proc>& proc_vec, const string& sorting, bool reverse, bool paused, int& c_index, const int index_max, bool collapsed) {
 		if (proc_vec.size() > 1 and not paused) {
 			if (reverse) {
@@ -152,6 +325,9 @@ bool set_priority(pid_t pid, int priority) {
 				case 5: rng::stable_sort(proc_vec, [](const auto& a, const auto& b) { return a.entry.get().mem < b.entry.get().mem; });	break;
 				case 6: rng::stable_sort(proc_vec, [](const auto& a, const auto& b) { return a.entry.get().cpu_p < b.entry.get().cpu_p; });	break;
 				case 7: rng::stable_sort(proc_vec, [](const auto& a, const auto& b) { return a.entry.get().cpu_c < b.entry.get().cpu_c; });	break;
+				case 8: rng::stable_sort(proc_vec, [](const auto& a, const auto& b) { return a.entry.get().minflt_rate < b.entry.get().minflt_rate; });	break;
+				case 9: rng::stable_sort(proc_vec, [](const auto& a, const auto& b) { return a.entry.get().majflt_rate < b.entry.get().majflt_rate; });	break;
+				case 10: rng::stable_sort(proc_vec, [](const auto& a, const auto& b) { return a.entry.get().wait_p < b.entry.get().wait_p; });	break;
 				}
 			}
 			else {
@@ -160,6 +336,9 @@ bool set_priority(pid_t pid, int priority) {
 				case 5: rng::stable_sort(proc_vec, [](const auto& a, const auto& b) { return a.entry.get().mem > b.entry.get().mem; });	break;
 				case 6: rng::stable_sort(proc_vec, [](const auto& a, const auto& b) { return a.entry.get().cpu_p > b.entry.get().cpu_p; });	break;
 				case 7: rng::stable_sort(proc_vec, [](const auto& a, const auto& b) { return a.entry.get().cpu_c > b.entry.get().cpu_c; });	break;
+				case 8: rng::stable_sort(proc_vec, [](const auto& a, const auto& b) { return a.entry.get().minflt_rate > b.entry.get().minflt_rate; });	break;
+				case 9: rng::stable_sort(proc_vec, [](const auto& a, const auto& b) { return a.entry.get().majflt_rate > b.entry.get().majflt_rate; });	break;
+				case 10: rng::stable_sort(proc_vec, [](const auto& a, const auto& b) { return a.entry.get().wait_p > b.entry.get().wait_p; });	break;
 				}
 			}
 		}
@@ -172,24 +351,82 @@ bool set_priority(pid_t pid, int priority) {
 		}
 	}
 
-	auto matches_filter(const proc_info& proc, const std::string& filter) -> bool {
-		if (filter.starts_with("!")) {
-			if (filter.size() == 1) {
-				return true;
+	namespace {
+		//* Process filter compiled once per filter string and reused for all processes
+		//* Results are cached in proc_info::filter_gen and proc_info::filter_match, generations at or after
+		//* <true_from>/<false_from> are still valid for a cached true/false result
+		class CompiledFilter {
+			string filter;
+			string upper;
+			std::optional<std::regex> regex;
+			bool is_regex{};
+			uint64_t gen{};
+			uint64_t true_from{};
+			uint64_t false_from{};
+
+			auto contains_upper(const std::string_view str) const -> bool {
+				return std::search(str.begin(), str.end(), upper.begin(), upper.end(),
+					[](char ch1, char ch2) { return std::toupper(static_cast<unsigned char>(ch1)) == ch2; }) != str.end();
 			}
 
-			// An incomplete regex throws, see issue https://github.com/aristocratos/btop/issues/1133
-			try {
-				std::regex regex { filter.substr(1), std::regex::extended };
-				return std::regex_search(std::to_string(proc.pid), regex) || std::regex_search(proc.name, regex) ||
-							 std::regex_match(proc.cmd, regex) || std::regex_search(proc.user, regex);
-			} catch (std::regex_error& /* unused */) {
-				return false;
+			auto test(const proc_info& proc) const -> bool {
+				array<char, 24> pid_buf;
+				const std::string_view pid_str(pid_buf.data(), std::to_chars(pid_buf.data(), pid_buf.data() + pid_buf.size(), proc.pid).ptr);
+
+				if (is_regex) {
+					if (filter.size() == 1) return true;
+					if (not regex.has_value()) return false;
+					return std::regex_search(pid_str.begin(), pid_str.end(), *regex) || std::regex_search(proc.name.get(), *regex) ||
+								 std::regex_match(proc.cmd, *regex) || std::regex_search(proc.user.get(), *regex);
+				}
+
+				return pid_str.contains(filter) || contains_upper(proc.name) || contains_upper(proc.cmd) || contains_upper(proc.user);
+			}
+
+		public:
+			//* Compile <new_filter> if changed, results cached for the previous filter are kept if the change can't affect them
+			void set(const string& new_filter) {
+				if (gen != 0 and new_filter == filter) return;
+				const bool new_regex = new_filter.starts_with('!');
+				gen++;
+
+				//? A plain filter that contains the previous one can only match fewer processes, and the opposite when it is contained by it
+				if (gen > 1 and not is_regex and not new_regex) {
+					if (not s_contains_ic(new_filter, filter)) false_from = gen;
+					if (not s_contains_ic(filter, new_filter)) true_from = gen;
+				}
+				else true_from = false_from = gen;
+
+				filter = new_filter;
+				is_regex = new_regex;
+				regex.reset();
+				upper.clear();
+				if (is_regex) {
+					// An incomplete regex throws, see issue https://github.com/aristocratos/btop/issues/1133
+					try {
+						if (filter.size() > 1) regex.emplace(filter.substr(1), std::regex::extended);
+					} catch (std::regex_error& /* unused */) {}
+				}
+				else {
+					upper.reserve(filter.size());
+					for (const char ch : filter) upper.push_back(std::toupper(static_cast<unsigned char>(ch)));
+				}
 			}
-		}
 
-		return std::to_string(proc.pid).contains(filter) || s_contains_ic(proc.name, filter) ||
-					 s_contains_ic(proc.cmd, filter) || s_contains_ic(proc.user, filter);
+			auto matches(proc_info& proc) const -> bool {
+				if (proc.filter_gen != 0 and proc.filter_gen >= (proc.filter_match ? true_from : false_from))
+					return proc.filter_match;
+				proc.filter_match = test(proc);
+				proc.filter_gen = gen;
+				return proc.filter_match;
+			}
+		};
+	}
+
+	auto matches_filter(proc_info& proc, const std::string& filter) -> bool {
+		static CompiledFilter compiled;
+		compiled.set(filter);
+		return compiled.matches(proc);
 	}
 
 	void _tree_gen(proc_info& cur_proc, vector<proc_info>& in_procs, vector<tree_proc>& out_procs,
@@ -257,18 +494,30 @@ bool set_priority(pid_t pid, int priority) {
 		}
 	}
 
-	void _collect_prefixes(tree_proc &t, const bool is_last, const string &header) {
-		const bool is_filtered = t.entry.get().filtered;
-		if (is_filtered) t.entry.get().depth = 0;
+	void _collect_prefixes(tree_proc &t, const bool is_last, const uint64_t lines, const size_t level) {
+		auto& entry = t.entry.get();
+		const bool is_filtered = entry.filtered;
+		if (is_filtered) entry.depth = 0;
 
-		if (!t.children.empty()) t.entry.get().prefix = header + (t.entry.get().collapsed ? "[+]─": "[-]─");
-		else t.entry.get().prefix = header + (is_last ? " └─": " ├─");
+		entry.prefix_lines = lines;
+		entry.prefix_last = is_last;
+		entry.prefix_parent = not t.children.empty();
 
+		const uint64_t child_lines = (is_filtered ? 0 : lines | (is_last or level >= 64 ? 0 : 1ull << level));
 		for (auto child = t.children.begin(); child != t.children.end(); ++child) {
-			_collect_prefixes(*child, child == (t.children.end() - 1),
-				is_filtered ? "": header + (is_last ? "   ": " │ "));
+			_collect_prefixes(*child, child == (t.children.end() - 1), child_lines, (is_filtered ? 0 : level + 1));
 		}
 	}
+
+	auto tree_prefix(const proc_info& proc) -> string {
+		string out;
+		out.reserve(proc.depth * 5 + 8);
+		for (size_t i = 0; i < proc.depth; i++)
+			out += (i < 64 and (proc.prefix_lines >> i) & 1) ? " │ " : "   ";
+		if (proc.prefix_parent) out += proc.collapsed ? "[+]─" : "[-]─";
+		else out += proc.prefix_last ? " └─" : " ├─";
+		return out;
+	}
 }
 
 auto detect_container() -> std::optional<std::string> {
@@ -42,10 +42,14 @@ tab-size = 4
 # include <kvm.h>
 #endif
 
+#include "btop_tools.hpp"
+
 using std::array;
 using std::atomic;
 using std::deque;
+using Tools::RingBuffer;
 using std::string;
+using std::string_view;
 using std::tuple;
 using std::vector;
 
@@ -94,6 +98,52 @@ namespace Shared {
 
 	extern long coreCount, page_size, clk_tck;
 
+	//* System wide values sampled once per update, collectors and draw functions read these instead of sampling on their own
+	//* so all boxes of an update use the same data and timestamp
+	struct tick_snapshot {
+		uint64_t time_us{};    // when the snapshot was taken
+		double uptime{};       // seconds since boot
+		uint64_t total_mem{};  // bytes
+	#ifdef __linux__
+		string stat;           // contents of /proc/stat
+		string meminfo;        // contents of /proc/meminfo
+	#endif
+	};
+	extern tick_snapshot tick;
+
+	//* Take a new snapshot into <tick>, called by the runner before collecting an update
+	void update_tick();
+
+#ifdef __linux__
+	//* Usage of a cgroup v2 directory, fields are left at 0 if the controller file is missing
+	struct cgroup_stats {
+		uint64_t usage_usec{};      // cpu time from cpu.stat
+		uint64_t nr_throttled{};    // periods throttled by cpu.max, from cpu.stat
+		uint64_t throttled_usec{};  // time throttled by cpu.max, from cpu.stat
+		uint64_t mem_current{};     // memory.current
+		uint64_t mem_max{};         // memory.max, 0 if unlimited
+		uint64_t io_read{};         // rbytes summed over all devices in io.stat
+		uint64_t io_write{};        // wbytes summed over all devices in io.stat
+		bool has_io{};              // io.stat was read
+	};
+
+	//* Return directory of cgroup <name> below the cgroup v2 mount <root>, <name> may also be an absolute path inside <root>
+	//* Returns an empty path if <name> is empty or not a directory
+	auto cgroup_dir(const std::filesystem::path& root, const string& name) -> std::filesystem::path;
+
+	//* Append the pids in cgroup.procs of <dir> and all cgroups below it to <pids>, returns false if <dir> could not be read
+	bool read_cgroup_pids(const std::filesystem::path& dir, vector<size_t>& pids);
+
+	//* Read cpu, memory and io usage of the cgroup in <dir>, returns false if none of the files could be read
+	bool read_cgroup_stats(const std::filesystem::path& dir, cgroup_stats& stats);
+
+	//* Mount point of the cgroup v2 hierarchy, looked up once
+	auto cgroup_root() -> const std::filesystem::path&;
+
+	//* Directory of the cgroup entered from the cgroup view or else selected with proc_cgroup, empty if not set or not found
+	auto selected_cgroup() -> const std::filesystem::path&;
+#endif
+
 #if defined(__FreeBSD__) || defined(__OpenBSD__) || defined(__NetBSD__)
 	struct KvmDeleter {
 		void operator()(kvm_t* handle) {
@@ -118,7 +168,15 @@ namespace Gpu {
 	extern vector<int> gpu_b_height_offsets;
 	extern long long gpu_pwr_total_max;
 
-	extern std::unordered_map<string, deque<long long>> shared_gpu_percent; // averages, power/vram total
+	//* Series of Gpu::shared_gpu_percent, names are used by the cpu_graph_upper/lower options
+	enum class shared_field { average, vram_total, pwr_total };
+	inline constexpr array shared_field_names { "gpu-average"sv, "gpu-vram-total"sv, "gpu-pwr-total"sv };
+
+	//* Series of gpu_info::gpu_percent, names are used by the cpu_graph_upper/lower options
+	enum class gpu_field { totals, vram_totals, pwr_totals };
+	inline constexpr array gpu_field_names { "gpu-totals"sv, "gpu-vram-totals"sv, "gpu-pwr-totals"sv };
+
+	extern Tools::EnumMap<shared_field, RingBuffer<long long>, shared_field_names> shared_gpu_percent; // averages, power/vram total
 
 	const array mem_names { "used"s, "free"s };
 
@@ -146,23 +204,19 @@ namespace Gpu {
 
 	//* Per-device container for GPU info
 	struct gpu_info {
-		std::unordered_map<string, deque<long long>> gpu_percent = {
-			{"gpu-totals", {}},
-			{"gpu-vram-totals", {}},
-			{"gpu-pwr-totals", {}},
-		};
+		Tools::EnumMap<gpu_field, RingBuffer<long long>, gpu_field_names> gpu_percent;
 		unsigned int gpu_clock_speed; // MHz
 
 		long long pwr_usage; // mW
 		long long pwr_max_usage = 255000;
 		long long pwr_state;
 
-		deque<long long> temp = {0};
+		RingBuffer<long long> temp = {0};
 		long long temp_max = 110;
 
 		long long mem_total = 0;
 		long long mem_used = 0;
-		deque<long long> mem_utilization_percent = {0}; // TODO: properly handle GPUs that can't report some stats
+		RingBuffer<long long> mem_utilization_percent = {0}; // TODO: properly handle GPUs that can't report some stats
 		long long mem_clock_speed = 0; // MHz
 
 		long long pcie_tx = 0; // KB/s
@@ -207,37 +261,50 @@ namespace Cpu {
 	extern string box;
 	extern int x, y, width, height, min_width, min_height;
 	extern bool shown, redraw, got_sensors, cpu_temp_only, has_battery, supports_watts;
+	extern bool has_core_freq; // cpu_info::core_freq can be collected, only on Linux
 	extern string cpuName, cpuHz;
 	extern vector<string> available_fields;
 	extern vector<string> available_sensors;
 	extern tuple<int, float, long, string> current_bat;
 	extern std::optional<std::string> container_engine;
 
+	//* Series of cpu_info::cpu_percent, names are used by the cpu_graph_upper/lower options
+	enum class cpu_field { total, user, nice, system, idle, iowait, irq, softirq, steal, guest, guest_nice };
+	inline constexpr array cpu_field_names {
+		"total"sv, "user"sv, "nice"sv, "system"sv, "idle"sv, "iowait"sv,
+		"irq"sv, "softirq"sv, "steal"sv, "guest"sv, "guest_nice"sv
+	};
+
 	struct cpu_info {
-		std::unordered_map<string, deque<long long>> cpu_percent = {
-			{"total", {}},
-			{"user", {}},
-			{"nice", {}},
-			{"system", {}},
-			{"idle", {}},
-			{"iowait", {}},
-			{"irq", {}},
-			{"softirq", {}},
-			{"steal", {}},
-			{"guest", {}},
-			{"guest_nice", {}}
-		};
-		vector<deque<long long>> core_percent;
-		vector<deque<long long>> temp;
+		Tools::EnumMap<cpu_field, RingBuffer<long long>, cpu_field_names> cpu_percent;
+		vector<RingBuffer<long long>> core_percent;
+		vector<RingBuffer<long long>> temp;
 		long long temp_max = 0;
+		vector<long long> core_freq; // current frequency of each core in MHz, 0 if unknown, only filled if show_core_freq is set
+		vector<long long> core_freq_max; // maximum frequency of each core in MHz, 0 if unknown
 		array<double, 3> load_avg;
 		float usage_watts = 0;
 		std::optional<std::vector<std::int32_t>> active_cpus;
+		double cgroup_percent = -1; // cpu usage of the cgroup selected with proc_cgroup (Linux), -1 if not available
 	};
 
 	//* Collect cpu stats and temperatures
 	auto collect(bool no_update = false) -> cpu_info&;
 
+#ifdef __linux__
+	//* Fields of a "cpu" or "cpuN" line of /proc/stat, parsed without allocating
+	struct cpu_stat_line {
+		int core{-1};                     // -1 for the "cpu" line with the totals of all cores
+		std::array<long long, 10> fields; // user nice system idle iowait irq softirq steal guest guest_nice, fields after these are not stored
+		size_t count{};                   // number of fields on the line
+		long long total{};                // sum of the fields up to steal, guest time is already counted in user and nice
+		long long idle{};                 // idle and iowait
+	};
+
+	//* Parse one line of /proc/stat starting with "cpu", returns false if the core number is malformed or there are less than 4 fields
+	bool parse_cpu_stat_line(string_view line, cpu_stat_line& out);
+#endif
+
 	//* Draw contents of cpu box using <cpu> as source
     string draw(const cpu_info& cpu, const vector<Gpu::gpu_info>& gpu, bool force_redraw = false, bool data_same = false);
 
@@ -259,6 +326,10 @@ namespace Mem {
 	extern bool has_swap, shown, redraw;
 	const array mem_names { "used"s, "available"s, "cached"s, "free"s };
 	const array swap_names { "swap_used"s, "swap_free"s };
+
+	//* Keys of mem_info::stats and mem_info::percent
+	enum class mem_field { used, available, cached, free, swap_total, swap_used, swap_free };
+	inline constexpr array mem_field_names { "used"sv, "available"sv, "cached"sv, "free"sv, "swap_total"sv, "swap_used"sv, "swap_free"sv };
 	extern int disk_ios;
 
 	struct disk_info {
@@ -273,20 +344,20 @@ namespace Mem {
 		int free_percent{};
 
 		array<int64_t, 3> old_io = {0, 0, 0};
-		deque<long long> io_read = {};
-		deque<long long> io_write = {};
-		deque<long long> io_activity = {};
+		RingBuffer<long long> io_read = {};
+		RingBuffer<long long> io_write = {};
+		RingBuffer<long long> io_activity = {};
 	};
 
 	struct mem_info {
-		std::unordered_map<string, uint64_t> stats =
-			{{"used", 0}, {"available", 0}, {"cached", 0}, {"free", 0},
-			{"swap_total", 0}, {"swap_used", 0}, {"swap_free", 0}};
-		std::unordered_map<string, deque<long long>> percent =
-			{{"used", {}}, {"available", {}}, {"cached", {}}, {"free", {}},
-			{"swap_total", {}}, {"swap_used", {}}, {"swap_free", {}}};
+		Tools::EnumMap<mem_field, uint64_t, mem_field_names> stats;
+		Tools::EnumMap<mem_field, RingBuffer<long long>, mem_field_names> percent;
 		std::unordered_map<string, disk_info> disks;
 		vector<string> disks_order;
+		//? Memory use and limit of the cgroup selected with proc_cgroup (Linux), limit is 0 if unlimited
+		bool cgroup{};
+		uint64_t cgroup_current{};
+		uint64_t cgroup_max{};
 	};
 
 	//?* Get total system memory
@@ -307,7 +378,15 @@ namespace Net {
 	extern string selected_iface;
 	extern vector<string> interfaces;
 	extern bool rescale;
-	extern std::unordered_map<string, uint64_t> graph_max;
+
+	enum class direction { download, upload };
+	inline constexpr array direction_names { "download"sv, "upload"sv };
+
+	//* Value per direction, indexed by Net::direction or by name
+	template <typename T>
+	using direction_map = Tools::EnumMap<direction, T, direction_names>;
+
+	extern direction_map<uint64_t> graph_max;
 
 	struct net_stat {
 		uint64_t speed{};
@@ -319,8 +398,8 @@ namespace Net {
 	};
 
 	struct net_info {
-		std::unordered_map<string, deque<long long>> bandwidth = { {"download", {}}, {"upload", {}} };
-		std::unordered_map<string, net_stat> stat = { {"download", {}}, {"upload", {}} };
+		direction_map<RingBuffer<long long>> bandwidth;
+		direction_map<net_stat> stat;
 		string ipv4{};      // defaults to ""
 		string ipv6{};      // defaults to ""
 		bool connected{};
@@ -373,6 +452,11 @@ namespace Proc {
 		"memory",
 		"cpu direct",
 		"cpu lazy",
+	#ifdef __linux__
+		"minor faults",
+		"major faults",
+		"top waiters",
+	#endif
 	};
 
 	//? Translation from process state char to explanative string
@@ -393,12 +477,12 @@ namespace Proc {
 	//* Container for process information
 	struct proc_info {
 		size_t pid{};
-		string name{};          // defaults to ""
+		//? Usernames, program names and short commands repeat across many processes and are shared
+		Tools::InternedString name{};
 		string cmd{};           // defaults to ""
-		string short_cmd{};     // defaults to ""
+		Tools::InternedString short_cmd{};
 		size_t threads{};
-		int name_offset{};
-		string user{};          // defaults to ""
+		Tools::InternedString user{};
 		uint64_t mem{};
 		double cpu_p{};         // defaults to = 0.0
 		double cpu_c{};         // defaults to = 0.0
@@ -407,28 +491,111 @@ namespace Proc {
 		uint64_t ppid{};
 		uint64_t cpu_s{};
 		uint64_t cpu_t{};
+		uint64_t cputimes_read{};
 		uint64_t death_time{};
-		string prefix{};        // defaults to ""
+		uint64_t seen_gen{};
+		uint64_t filter_gen{};  // 0 if the cached filter result is invalid
+		uint64_t prefix_lines{};  // bit n set if the tree prefix continues a line at depth n
+		uint64_t tree_ppid{};     // parent the process is linked under in the persistent tree (Linux)
+		uint64_t tree_stamp{};    // last tree generation that visited the process (Linux)
 		size_t depth{};
 		size_t tree_index{};
 		bool collapsed{};
 		bool filtered{};
+		bool filter_match{};
+		bool prefix_last{};       // last child of its parent in the tree
+		bool prefix_parent{};     // has children in the tree
+		bool tree_linked{};
+		uint64_t minflt{};      // page fault counts from the last read of /proc/[pid]/stat (Linux)
+		uint64_t majflt{};
+		double minflt_rate{};   // minor page faults per second
+		double majflt_rate{};   // major page faults per second
+		uint64_t wait_ns{};     // run queue wait from /proc/[pid]/schedstat and when it was read, for the "top waiters" sorting (Linux)
+		uint64_t wait_read_us{};
+		size_t group_count{};   // processes summed into a row of the program view, 0 for a single process
+		//? Values for the optional proc_columns, only read for processes in or near the visible part of the list (Linux), -1 if unknown
+		int64_t io_read_rate{-1};   // bytes per second
+		int64_t io_write_rate{-1};  // bytes per second
+		int64_t fds{-1};
+		double wait_p{-1};          // percent of time spent waiting for a cpu
+		double vctx_rate{-1};       // voluntary context switches per second
+		double nvctx_rate{-1};      // involuntary context switches per second
+	};
+
+	//* Values that the sort and tree passes read for every process, one vector per field
+	//* Row i holds entry i of the list it was filled from and is only valid until that list is reordered
+	struct hot_columns {
+		size_t sort_key{};      // index in sort_vector that <key> was filled for
+		vector<uint64_t> key;   // sort key as an unsigned integer in ascending order, strings by their first 8 bytes
+		vector<double> cpu_p;   // for the "cpu lazy" threshold
+
+		auto size() const -> size_t { return key.size(); }
+
+		//* Fill the columns from <procs> in list order with keys for sort_vector[<sort_key>]
+		void fill(const vector<proc_info>& procs, size_t sort_key);
+
+		//* Refill row <row> after the values of <proc> changed
+		void set(size_t row, const proc_info& proc);
+	};
+
+#ifdef __linux__
+	//* Fields of /proc/[pid]/stat, <name> points into the parsed buffer
+	struct pid_stat {
+		string_view name{};
+		char state{};
+		uint64_t ppid{};
+		uint64_t flags{};
+		uint64_t minflt{};
+		uint64_t majflt{};
+		uint64_t utime{};
+		uint64_t stime{};
+		int64_t priority{};
+		int64_t nice{};
+		uint64_t threads{};
+		uint64_t starttime{};
+		uint64_t rss{};
+		int processor{};
+		uint64_t rt_priority{};
+		uint64_t blkio_ticks{};
 	};
 
+	//* Parse contents of /proc/[pid]/stat in one pass, the name is found by the last ')' so names with spaces or parentheses are handled
+	//* Returns false if any field up to rss is missing, fields after rss are left at 0 if missing
+	bool parse_pid_stat(string_view buf, pid_stat& out);
+#endif
+
 	//* Container for process info box
 	struct detail_container {
 		size_t last_pid{};
 		bool skip_smaps{};
 		proc_info entry;
-		string elapsed, parent, status, io_read, io_write, memory;
+		string elapsed, parent, status, io_read, io_write, memory, mem_detail, faults;
 		long long first_mem = -1;
-		deque<long long> cpu_percent;
-		deque<long long> mem_bytes;
+		long long fault_max = -1;
+		RingBuffer<long long> cpu_percent;
+		RingBuffer<long long> fault_rate; // minor and major page faults per second
+		RingBuffer<long long> wait_percent; // percent of time spent waiting on a run queue, empty if not available
+		RingBuffer<long long> mem_bytes;
+		RingBuffer<long long> pss_bytes, uss_bytes, swap_bytes, anon_huge_bytes; // from smaps_rollup or smaps, empty if not read
 	};
 
 	//? Contains all info for proc detailed box
 	extern detail_container detailed;
 
+	//* Usage of a cgroup v2 in the cgroup view of the process box (Linux)
+	struct cgroup_info {
+		string path;                // relative to the cgroup2 mount point, "/" for the root cgroup
+		double cpu_p{};
+		uint64_t mem{};
+		int64_t io_read_rate{-1};   // bytes per second, -1 if unknown
+		int64_t io_write_rate{-1};
+		double throttled_p{};       // percent of time throttled by cpu.max
+		uint64_t nr_throttled{};
+	};
+
+	//? Cgroups shown in the cgroup view, in display order
+	extern vector<cgroup_info> cgroups;
+
 	//* Collect and sort process information from /proc
 	auto collect(bool no_update = false) -> vector<proc_info>&;
 
@@ -446,22 +613,34 @@ namespace Proc {
 	//* Change priority (nice) of pid, returns true on success otherwise false
 	bool set_priority(pid_t pid, int priority);
 
-	//* Sort vector of proc_info's
-	void proc_sorter(vector<proc_info>& proc_vec, const string& sorting, bool reverse, bool tree = false);
+	//* Sort vector of proc_info's, gives the same order as a stable sort on the selected column
+	//* If <sort_count> is not 0 only the first <sort_count> entries are ordered and the rest are left in unspecified order
+	//* Keys are read from <columns> if given, filled from <proc_vec> in its current order for the same sorting
+	void proc_sorter(vector<proc_info>& proc_vec, const string& sorting, bool reverse, bool tree = false, size_t sort_count = 0,
+					 const hot_columns* columns = nullptr);
+
+	//* Replace <plist> with one row per program name for the program view, summing cpu, memory and threads of all processes not filtered out
+	//* The rows are sorted with proc_sorter and numpids is set to the number of rows
+	void aggregate(vector<proc_info>& plist, const string& sorting, bool reverse);
 
 	//* Recursive sort of process tree
 	void tree_sort(vector<tree_proc>& proc_vec, const string& sorting, bool reverse, bool paused,
 					int& c_index, const int index_max, bool collapsed = false);
 
-	auto matches_filter(const proc_info& proc, const std::string& filter) -> bool;
+	//* Returns true if <proc> matches <filter>, the filter is compiled once per change and the result is cached in <proc>
+	//* Collectors must reset proc_info::filter_gen to 0 when name, cmd or user of an existing process changes
+	auto matches_filter(proc_info& proc, const std::string& filter) -> bool;
 
 	//* Generate process tree list
 	void _tree_gen(proc_info& cur_proc, vector<proc_info>& in_procs, vector<tree_proc>& out_procs,
 				   int cur_depth, bool collapsed, const string& filter,
 				   bool found = false, bool no_update = false, bool should_filter = false);
 
-	//* Build prefixes for tree view
-	void _collect_prefixes(tree_proc& t, bool is_last, const string &header = "");
+	//* Build prefixes for tree view, <lines> and <level> are the prefix of the parent
+	void _collect_prefixes(tree_proc& t, bool is_last, uint64_t lines = 0, size_t level = 0);
+
+	//* Render the tree view prefix built by _collect_prefixes() for <proc>
+	auto tree_prefix(const proc_info& proc) -> string;
 }
 
 /// Detect container engine.
@@ -16,12 +16,14 @@ indent = tab
 tab-size = 4
 */
 
+#include <cerrno>
 #include <cmath>
 #include <ctime>
 #include <filesystem>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
 #include <sstream>
 #include <string_view>
 #include <utility>
@@ -513,6 +515,15 @@ namespace Tools {
 		return out;
 	}
 
+	string count_humanizer(double value) {
+		static const array suffixes { "k", "M", "G", "T" };
+		if (value < 999.5) return fmt::format("{:.0f}", max(0.0, value));
+		size_t unit{};
+		for (value /= 1000; value >= 999.5 and unit < suffixes.size() - 1; unit++) value /= 1000;
+		if (value < 9.95) return fmt::format("{:.1f}{}", value, suffixes[unit]);
+		return fmt::format("{:.0f}{}", value, suffixes[unit]);
+	}
+
 	std::string operator*(const string& str, int64_t n) {
 		if (n < 1 or str.empty()) {
 			return "";
@@ -558,20 +569,191 @@ namespace Tools {
 		this->atom.notify_all();
 	}
 
-	string readfile(const std::filesystem::path& path, const string& fallback) {
-		if (not fs::exists(path)) return fallback;
-		string out;
+	WorkerPool::~WorkerPool() noexcept {
+		stop();
+	}
+
+	void WorkerPool::stop() noexcept {
+		{
+			std::lock_guard lock(mtx);
+			stopping = true;
+		}
+		work_cv.notify_all();
+		for (auto& thread : threads) thread.join();
+		threads.clear();
+		stopping = false;
+	}
+
+	void WorkerPool::worker(size_t shard, uint64_t seen) {
+		std::unique_lock lock(mtx);
+		while (true) {
+			work_cv.wait(lock, [&] { return stopping or generation != seen; });
+			if (stopping) return;
+			seen = generation;
+			lock.unlock();
+			try {
+				(*job)(shard);
+			}
+			catch (...) {
+				lock.lock();
+				if (not error) error = std::current_exception();
+				lock.unlock();
+			}
+			lock.lock();
+			if (--pending == 0) done_cv.notify_one();
+		}
+	}
+
+	void WorkerPool::resize(size_t shards) {
+		shards = max((size_t)1, shards);
+		if (shards == this->shards()) return;
+		stop();
+		std::lock_guard lock(mtx);
+		for (size_t i = 1; i < shards; i++)
+			threads.emplace_back(&WorkerPool::worker, this, i, generation);
+	}
+
+	void WorkerPool::run(const std::function<void(size_t)>& fn) {
+		{
+			std::lock_guard lock(mtx);
+			job = &fn;
+			pending = threads.size();
+			error = nullptr;
+			generation++;
+		}
+		work_cv.notify_all();
+
+		std::exception_ptr own_error;
 		try {
-			std::ifstream file(path);
-			for (string readstr; getline(file, readstr); out += readstr);
+			fn(0);
 		}
-		catch (const std::exception& e) {
-			Logger::error("readfile() : Exception when reading {} : {}", path, e.what());
-			return fallback;
+		catch (...) {
+			own_error = std::current_exception();
 		}
+
+		std::unique_lock lock(mtx);
+		done_cv.wait(lock, [&] { return pending == 0; });
+		job = nullptr;
+		if (not own_error) own_error = std::exchange(error, nullptr);
+		if (own_error) std::rethrow_exception(own_error);
+	}
+
+	string readfile(const std::filesystem::path& path, const string& fallback) {
+		auto buf = read_at(AT_FDCWD, path.c_str());
+		if (not buf.has_value()) return fallback;
+		string out;
+		out.reserve(buf->size());
+		std::ranges::copy_if(*buf, std::back_inserter(out), [](char c) { return c != '\n'; });
 		return (out.empty() ? fallback : out);
 	}
 
+	DirFd::DirFd(const std::filesystem::path& path)
+		: fd(open(path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC)) {}
+
+	DirFd::~DirFd() noexcept {
+		if (fd >= 0) close(fd);
+	}
+
+	DirFd& DirFd::operator=(DirFd&& other) noexcept {
+		if (this != &other) {
+			if (fd >= 0) close(fd);
+			fd = std::exchange(other.fd, -1);
+		}
+		return *this;
+	}
+
+	namespace {
+		//* Read <fd> from offset 0 into the buffer of the calling thread, shared by read_at() and FileFd::read()
+		auto read_fd(int fd, size_t max_size, bool single_record) -> std::optional<string_view> {
+			thread_local vector<char> buffer(4096);
+
+			size_t len = 0;
+			for (;;) {
+				if (max_size > 0 and len >= max_size) break;
+				//? Pseudo files report a size of 0 or 4096, so grow the buffer when it fills up instead of trusting fstat()
+				if (len == buffer.size()) buffer.resize(buffer.size() * 2);
+				const size_t want = (max_size > 0 ? std::min(buffer.size(), max_size) : buffer.size()) - len;
+				const ssize_t got = pread(fd, buffer.data() + len, want, len);
+				if (got < 0) {
+					if (errno == EINTR) continue;
+					return std::nullopt;
+				}
+				if (got == 0) break;
+				len += got;
+				if (single_record and std::cmp_less(got, want)) break;
+			}
+			return string_view{buffer.data(), len};
+		}
+	}
+
+	auto read_at(int dirfd, const char* name, size_t max_size, bool single_record) -> std::optional<string_view> {
+		const int fd = openat(dirfd, name, O_RDONLY | O_CLOEXEC);
+		if (fd < 0) return std::nullopt;
+		auto buf = read_fd(fd, max_size, single_record);
+		close(fd);
+		return buf;
+	}
+
+	FileFd::FileFd(int dirfd, const char* name)
+		: fd(openat(dirfd, name, O_RDONLY | O_CLOEXEC)) {}
+
+	FileFd::~FileFd() noexcept {
+		if (fd >= 0) close(fd);
+	}
+
+	FileFd& FileFd::operator=(FileFd&& other) noexcept {
+		if (this != &other) {
+			if (fd >= 0) close(fd);
+			fd = std::exchange(other.fd, -1);
+		}
+		return *this;
+	}
+
+	auto FileFd::read(size_t max_size, bool single_record) const -> std::optional<string_view> {
+		if (fd < 0) return std::nullopt;
+		return read_fd(fd, max_size, single_record);
+	}
+
+	auto find_key(string_view str, string_view key) -> std::optional<string_view> {
+		for (size_t pos = 0; pos < str.size();) {
+			auto line = str.substr(pos, str.find('\n', pos) - pos);
+			pos += line.size() + 1;
+			if (line.size() > key.size() and line.starts_with(key) and line[key.size()] == ':') {
+				line.remove_prefix(key.size() + 1);
+				while (not line.empty() and (line.front() == ' ' or line.front() == '\t')) line.remove_prefix(1);
+				return line;
+			}
+		}
+		return std::nullopt;
+	}
+
+	const string InternedString::empty_string{};
+
+	auto InternedString::intern(string_view value) -> std::shared_ptr<const string> {
+		//? Keys point into the pooled strings, an entry is erased by the deleter of the string it points into
+		//? The pool is never destroyed since strings held by other static objects are released during exit
+		static auto& pool_mtx = *new std::mutex;
+		static auto& pool = *new std::unordered_map<string_view, std::weak_ptr<const string>>;
+		if (value.empty()) return nullptr;
+
+		std::lock_guard lock(pool_mtx);
+		if (auto found = pool.find(value); found != pool.end()) {
+			if (auto shared = found->second.lock()) return shared;
+			//? The last holder is releasing it right now, replace the entry so the pending deleter leaves the new one alone
+			pool.erase(found);
+		}
+		std::shared_ptr<const string> shared(new string(value), [](const string* pooled) {
+			{
+				std::lock_guard lock(pool_mtx);
+				if (auto found = pool.find(*pooled); found != pool.end() and found->first.data() == pooled->data())
+					pool.erase(found);
+			}
+			delete pooled;
+		});
+		pool.emplace(*shared, shared);
+		return shared;
+	}
+
 	auto celsius_to(const long long& celsius, const string& scale) -> tuple<long long, string> {
 		if (scale == "celsius")
 			return {celsius, "°C"};
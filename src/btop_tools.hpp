@@ -25,17 +25,30 @@ tab-size = 4
 #include <algorithm>        // for std::ranges::count_if
 #include <array>
 #include <atomic>
+#include <charconv>
 #include <chrono>
+#include <condition_variable>
 #include <cstdint>
+#include <exception>
 #include <filesystem>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
 #include <limits.h>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <ranges>
 #include <regex>
+#include <span>
+#include <stdexcept>
 #include <string>
 #include <string_view>
 #include <thread>
 #include <tuple>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 #ifdef BTOP_DEBUG
 #include <source_location>
@@ -311,6 +324,9 @@ namespace Tools {
 	//* shorten=true shortens value to at most 3 characters and shortens unit to 1 character
 	string floating_humanizer(uint64_t value, bool shorten = false, size_t start = 0, bool bit = false, bool per_second = false);
 
+	//* Scales up in steps of 1000 and returns string of at most 4 characters with a k, M, G or T suffix, e.g. "950", "1.2k" or "34M"
+	string count_humanizer(double value);
+
 	//* Add std::string operator * : Repeat string <str> <n> number of times
 	std::string operator*(const string& str, int64_t n);
 
@@ -356,6 +372,196 @@ namespace Tools {
 	};
 #endif
 
+	//* Map with the fixed set of keys given by the enumerators of <E>, stored as an array indexed by the enum value
+	//* <Names> holds the name of each enumerator in declaration order, used by config options and code that looks up values by name
+	template <typename E, typename T, const auto& Names>
+	class EnumMap {
+		std::array<std::pair<string, T>, std::size(Names)> entries;
+
+		static E key(std::string_view name) {
+			if (auto key = find(name)) return *key;
+			throw std::out_of_range(fmt::format("EnumMap: invalid key: {}", name));
+		}
+	public:
+		EnumMap() {
+			for (size_t i = 0; i < entries.size(); i++) entries[i].first = Names[i];
+		}
+
+		//* Enumerator named <name>, or std::nullopt if <name> is not a key
+		static constexpr std::optional<E> find(std::string_view name) noexcept {
+			for (size_t i = 0; i < std::size(Names); i++) {
+				if (Names[i] == name) return static_cast<E>(i);
+			}
+			return std::nullopt;
+		}
+
+		static constexpr std::string_view name(E key) noexcept { return Names[std::to_underlying(key)]; }
+		static constexpr size_t size() noexcept { return std::size(Names); }
+
+		T& operator[](E key) noexcept { return entries[std::to_underlying(key)].second; }
+		const T& operator[](E key) const noexcept { return entries[std::to_underlying(key)].second; }
+
+		//* Lookup by name, throws std::out_of_range if <name> is not a key
+		T& at(std::string_view name) { return (*this)[key(name)]; }
+		const T& at(std::string_view name) const { return (*this)[key(name)]; }
+		T& operator[](std::string_view name) { return at(name); }
+		bool contains(std::string_view name) const noexcept { return find(name).has_value(); }
+
+		//* Iterates over pairs of name and value in enum order
+		auto begin() noexcept { return entries.begin(); }
+		auto end() noexcept { return entries.end(); }
+		auto begin() const noexcept { return entries.begin(); }
+		auto end() const noexcept { return entries.end(); }
+	};
+
+	//* Ring buffer holding the newest values of a graph history, pushing to a full buffer evicts the oldest value
+	//* Storage is only reallocated when the capacity changes, or while a buffer without a capacity grows,
+	//* so unlike std::deque, pushing and evicting values doesn't allocate
+	template <typename T>
+	class RingBuffer {
+		vector<T> buf;
+		size_t head{};
+		size_t count{};
+		size_t limit = std::numeric_limits<size_t>::max();
+
+		size_t slot(size_t index) const noexcept {
+			index += head;
+			return index >= buf.size() ? index - buf.size() : index;
+		}
+
+		//* Move the values to the start of a new buffer of <slots> slots
+		void relocate(size_t slots) {
+			vector<T> next(slots);
+			const auto [first, second] = spans();
+			std::ranges::copy(second, std::ranges::copy(first, next.begin()).out);
+			buf = std::move(next);
+			head = 0;
+		}
+
+		template <bool Const>
+		class basic_iterator {
+			using buffer_ptr = std::conditional_t<Const, const RingBuffer*, RingBuffer*>;
+			buffer_ptr ring{};
+			std::ptrdiff_t index{};
+		public:
+			using iterator_category = std::random_access_iterator_tag;
+			using value_type = T;
+			using difference_type = std::ptrdiff_t;
+			using reference = std::conditional_t<Const, const T&, T&>;
+
+			basic_iterator() = default;
+			basic_iterator(buffer_ptr ring, difference_type index) : ring(ring), index(index) {}
+			operator basic_iterator<true>() const requires (not Const) { return {ring, index}; }
+
+			reference operator*() const { return (*ring)[index]; }
+			reference operator[](difference_type n) const { return (*ring)[index + n]; }
+			basic_iterator& operator++() { ++index; return *this; }
+			basic_iterator& operator--() { --index; return *this; }
+			basic_iterator operator++(int) { auto it = *this; ++index; return it; }
+			basic_iterator operator--(int) { auto it = *this; --index; return it; }
+			basic_iterator& operator+=(difference_type n) { index += n; return *this; }
+			basic_iterator& operator-=(difference_type n) { index -= n; return *this; }
+			basic_iterator operator+(difference_type n) const { return {ring, index + n}; }
+			basic_iterator operator-(difference_type n) const { return {ring, index - n}; }
+			friend basic_iterator operator+(difference_type n, const basic_iterator& it) { return it + n; }
+			difference_type operator-(const basic_iterator& other) const { return index - other.index; }
+			bool operator==(const basic_iterator& other) const { return index == other.index; }
+			auto operator<=>(const basic_iterator& other) const { return index <=> other.index; }
+		};
+	public:
+		using value_type = T;
+		using iterator = basic_iterator<false>;
+		using const_iterator = basic_iterator<true>;
+		using reverse_iterator = std::reverse_iterator<iterator>;
+		using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+		RingBuffer() = default;
+		RingBuffer(std::initializer_list<T> values) : buf(values), count(values.size()) {}
+
+		//* Maximum number of values kept, no limit until set_capacity() is called
+		size_t capacity() const noexcept { return limit; }
+
+		//* Set the maximum number of values kept to <n>, evicting the oldest values if there are more than <n>
+		void set_capacity(size_t n) {
+			if (n == limit) return;
+			if (count > n) {
+				head = slot(count - n);
+				count = n;
+			}
+			relocate(n);
+			limit = n;
+		}
+
+		void push_back(const T& value) {
+			if (limit == 0) return;
+			if (count == limit) {
+				buf[head] = value;
+				head = slot(1);
+				return;
+			}
+			if (count == buf.size()) relocate(std::min(limit, std::max<size_t>(16, buf.size() * 2)));
+			buf[slot(count++)] = value;
+		}
+
+		void pop_front() noexcept {
+			head = slot(1);
+			if (--count == 0) head = 0;
+		}
+
+		void clear() noexcept { head = count = 0; }
+
+		size_t size() const noexcept { return count; }
+		bool empty() const noexcept { return count == 0; }
+
+		T& operator[](size_t index) noexcept { return buf[slot(index)]; }
+		const T& operator[](size_t index) const noexcept { return buf[slot(index)]; }
+		const T& at(size_t index) const {
+			if (index >= count) throw std::out_of_range(fmt::format("RingBuffer: index {} out of range for size {}", index, count));
+			return (*this)[index];
+		}
+		T& at(size_t index) { return const_cast<T&>(std::as_const(*this).at(index)); }
+		T& front() noexcept { return buf[head]; }
+		const T& front() const noexcept { return buf[head]; }
+		T& back() noexcept { return buf[slot(count - 1)]; }
+		const T& back() const noexcept { return buf[slot(count - 1)]; }
+
+		//* The values from oldest to newest as two contiguous spans, the second is empty unless the values wrap around the buffer
+		std::pair<std::span<const T>, std::span<const T>> spans() const noexcept {
+			const size_t first = std::min(count, buf.size() - head);
+			return {{buf.data() + head, first}, {buf.data(), count - first}};
+		}
+
+		iterator begin() noexcept { return {this, 0}; }
+		iterator end() noexcept { return {this, (std::ptrdiff_t)count}; }
+		const_iterator begin() const noexcept { return {this, 0}; }
+		const_iterator end() const noexcept { return {this, (std::ptrdiff_t)count}; }
+		reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+		reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+		const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+		const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+	};
+
+	template <typename E, typename T, const auto& Names>
+#ifdef BTOP_DEBUG
+	const T& safeVal(const EnumMap<E, T, Names>& map, std::string_view key, const T& fallback = T{}, std::source_location loc = std::source_location::current()) {
+		if (auto k = map.find(key)) {
+			return map[*k];
+		} else {
+			Logger::error("safeVal() called with invalid key: [{}] in file: {} on line: {}", key, loc.file_name(), loc.line());
+			return fallback;
+		}
+	};
+#else
+	const T& safeVal(const EnumMap<E, T, Names>& map, std::string_view key, const T& fallback = T{}) {
+		if (auto k = map.find(key)) {
+			return map[*k];
+		} else {
+			Logger::error("safeVal() called with invalid key: [{}] (Compile btop with DEBUG=true for more extensive logging!)", key);
+			return fallback;
+		}
+	};
+#endif
+
 
 
 	//* Return current time in <strf> format
@@ -381,9 +587,180 @@ namespace Tools {
 		atomic_lock& operator=(atomic_lock&& other) = delete;
 	};
 
+	//* Persistent pool of worker threads that splits a job in shards, the calling thread always runs shard 0
+	//* Worker threads inherit the signal mask of the thread that calls resize()
+	class WorkerPool {
+		vector<std::thread> threads;
+		std::mutex mtx;
+		std::condition_variable work_cv, done_cv;
+		const std::function<void(size_t)>* job{};
+		std::exception_ptr error;
+		uint64_t generation{};
+		size_t pending{};
+		bool stopping{};
+
+		void worker(size_t shard, uint64_t seen);
+		void stop() noexcept;
+	public:
+		WorkerPool() = default;
+		~WorkerPool() noexcept;
+		WorkerPool(const WorkerPool& other) = delete;
+		WorkerPool& operator=(const WorkerPool& other) = delete;
+		WorkerPool(WorkerPool&& other) = delete;
+		WorkerPool& operator=(WorkerPool&& other) = delete;
+
+		//* Set number of shards, <shards> - 1 worker threads are started
+		void resize(size_t shards);
+
+		//* Number of shards passed to run(), including the calling thread
+		[[nodiscard]] size_t shards() const noexcept { return threads.size() + 1; }
+
+		//* Call <fn>(shard) for every shard and wait for all to finish, rethrows the first exception thrown by any shard
+		void run(const std::function<void(size_t)>& fn);
+	};
+
 	//* Read a complete file and return as a string
 	string readfile(const std::filesystem::path& path, const string& fallback = "");
 
+	//* Owning wrapper for a directory file descriptor, used as base for relative lookups with read_at()
+	class DirFd {
+		int fd{-1};
+	public:
+		DirFd() = default;
+		explicit DirFd(const std::filesystem::path& path);
+		~DirFd() noexcept;
+		DirFd(const DirFd& other) = delete;
+		DirFd& operator=(const DirFd& other) = delete;
+		DirFd(DirFd&& other) noexcept : fd(std::exchange(other.fd, -1)) {}
+		DirFd& operator=(DirFd&& other) noexcept;
+		[[nodiscard]] int get() const noexcept { return fd; }
+		[[nodiscard]] explicit operator bool() const noexcept { return fd >= 0; }
+	};
+
+	//* Read file <name> relative to directory descriptor <dirfd> (or AT_FDCWD) into a buffer reused by the calling thread
+	//* Reads at most <max_size> bytes if not 0, returns std::nullopt if the file could not be opened or read
+	//* Set <single_record> for pseudo files that the kernel generates in one piece (like /proc/[pid]/stat),
+	//* a short read is then treated as end of file which saves one read() per file
+	//* The returned view is only valid until the next call to read_at() from the same thread
+	auto read_at(int dirfd, const char* name, size_t max_size = 0, bool single_record = false) -> std::optional<string_view>;
+
+	//* Owning wrapper for a file that is kept open and read again from the start on every update
+	//* Saves the open() and close() of read_at() for pseudo files in /proc and /sys that are read repeatedly
+	class FileFd {
+		int fd{-1};
+	public:
+		FileFd() = default;
+		FileFd(int dirfd, const char* name);
+		~FileFd() noexcept;
+		FileFd(const FileFd& other) = delete;
+		FileFd& operator=(const FileFd& other) = delete;
+		FileFd(FileFd&& other) noexcept : fd(std::exchange(other.fd, -1)) {}
+		FileFd& operator=(FileFd&& other) noexcept;
+		[[nodiscard]] int get() const noexcept { return fd; }
+		[[nodiscard]] explicit operator bool() const noexcept { return fd >= 0; }
+
+		//* Read the current contents with pread(), same arguments and buffer as read_at()
+		//* Returns std::nullopt if the file is not open or could not be read, e.g. after the process of a /proc/[pid] file exited
+		auto read(size_t max_size = 0, bool single_record = false) const -> std::optional<string_view>;
+	};
+
+	//* Scanner for whitespace separated fields in a string_view, numbers are parsed with std::from_chars
+	class FieldScanner {
+		string_view str;
+
+		static constexpr bool is_space(char c) noexcept { return c == ' ' or c == '\t' or c == '\n'; }
+
+		constexpr void skip_space() noexcept {
+			while (not str.empty() and is_space(str.front())) str.remove_prefix(1);
+		}
+	public:
+		constexpr explicit FieldScanner(string_view str) noexcept : str(str) {}
+
+		//* Return next field or an empty view if no fields are left
+		constexpr string_view next() noexcept {
+			skip_space();
+			size_t end = 0;
+			while (end < str.size() and not is_space(str[end])) end++;
+			auto field = str.substr(0, end);
+			str.remove_prefix(end);
+			return field;
+		}
+
+		//* Parse next field as a number into <value>, returns false and leaves <value> untouched on failure
+		template <typename T>
+		bool next(T& value) noexcept {
+			skip_space();
+			T parsed{};
+			auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), parsed);
+			if (ec != std::errc{} or (ptr != str.data() + str.size() and not is_space(*ptr))) {
+				next();
+				return false;
+			}
+			str.remove_prefix(ptr - str.data());
+			value = parsed;
+			return true;
+		}
+
+		//* Skip <n> fields
+		constexpr FieldScanner& skip(size_t n = 1) noexcept {
+			while (n-- > 0) next();
+			return *this;
+		}
+
+		//* Skip past the first occurrence of <c>, returns false if <c> was not found
+		constexpr bool skip_past(char c) noexcept {
+			auto pos = str.find(c);
+			str.remove_prefix(pos == string_view::npos ? str.size() : pos + 1);
+			return pos != string_view::npos;
+		}
+
+		//* Return the remaining part of the current line and advance to the start of the next line
+		constexpr string_view line() noexcept {
+			auto pos = str.find('\n');
+			auto rest = str.substr(0, pos);
+			str.remove_prefix(pos == string_view::npos ? str.size() : pos + 1);
+			return rest;
+		}
+
+		[[nodiscard]] constexpr string_view rest() const noexcept { return str; }
+		[[nodiscard]] constexpr bool empty() const noexcept { return str.empty(); }
+	};
+
+	//* Return the value of line "<key>:<value>" in <str> with leading whitespace removed, std::nullopt if <key> is missing
+	auto find_key(string_view str, string_view key) -> std::optional<string_view>;
+
+	//* Immutable string shared by all holders of the same content through a global pool, the empty string needs no storage
+	//* Pool entries are removed when the last holder goes away, interning and releasing is thread safe
+	class InternedString {
+		std::shared_ptr<const string> str;
+
+		static const string empty_string;
+		static auto intern(string_view value) -> std::shared_ptr<const string>;
+	public:
+		InternedString() = default;
+		explicit InternedString(string_view value) : str(intern(value)) {}
+		InternedString(const string& value) : str(intern(value)) {}
+		InternedString(const char* value) : str(intern(value)) {}
+
+		[[nodiscard]] const string& get() const noexcept { return str ? *str : empty_string; }
+		operator const string&() const noexcept { return get(); }
+		operator string_view() const noexcept { return get(); }
+
+		[[nodiscard]] size_t size() const noexcept { return get().size(); }
+		[[nodiscard]] bool empty() const noexcept { return str == nullptr; }
+		[[nodiscard]] const char* c_str() const noexcept { return get().c_str(); }
+		[[nodiscard]] string substr(size_t pos = 0, size_t count = string::npos) const { return get().substr(pos, count); }
+		void clear() noexcept { str.reset(); }
+
+		//* Equal content always shares storage, so comparing two interned strings only compares pointers
+		friend bool operator==(const InternedString& a, const InternedString& b) noexcept { return a.str == b.str; }
+		friend bool operator==(const InternedString& a, string_view b) noexcept { return a.get() == b; }
+		friend bool operator==(const InternedString& a, const char* b) noexcept { return a.get() == b; }
+		friend bool operator==(const InternedString& a, const string& b) noexcept { return a.get() == b; }
+		friend auto operator<=>(const InternedString& a, const InternedString& b) noexcept { return a.get() <=> b.get(); }
+		friend auto format_as(const InternedString& value) noexcept -> string_view { return value.get(); }
+	};
+
 	//* Convert a celsius value to celsius, fahrenheit, kelvin or rankin and return tuple with new value and unit.
 	auto celsius_to(const long long& celsius, const string& scale) -> tuple<long long, string>;
 }
@@ -785,7 +785,7 @@ namespace Net {
 	vector<string> interfaces;
 	string selected_iface;
 	int errors = 0;
-	std::unordered_map<string, uint64_t> graph_max = {{"download", {}}, {"upload", {}}};
+	direction_map<uint64_t> graph_max;
 	std::unordered_map<string, array<int, 2>> max_count = {{"download", {}}, {"upload", {}}};
 	bool rescale = true;
 	uint64_t timestamp = 0;
@@ -1082,7 +1082,7 @@ namespace Proc {
 		auto reverse = Config::getB("proc_reversed");
 		const auto &filter = Config::getS("proc_filter");
 		auto per_core = Config::getB("proc_per_core");
-		auto tree = Config::getB("proc_tree");
+		auto tree = Config::getB("proc_tree") and not Config::getB("proc_group_programs");
 		auto show_detailed = Config::getB("show_detailed");
 		const auto pause_proc_list = Config::getB("pause_proc_list");
 		const size_t detailed_pid = Config::getI("detailed_pid");
@@ -20,6 +20,7 @@ tab-size = 4
 #include <charconv>
 #include <cmath>
 #include <cstdlib>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <future>
@@ -27,16 +28,25 @@ tab-size = 4
 #include <numeric>
 #include <optional>
 #include <ranges>
+#include <span>
 #include <string_view>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
 
 #include <arpa/inet.h> // for inet_ntop()
+#include <dirent.h>
 #include <dlfcn.h>
+#include <fcntl.h>
 #include <ifaddrs.h>
+#include <linux/cn_proc.h>
+#include <linux/connector.h>
+#include <linux/netlink.h>
 #include <net/if.h>
 #include <netdb.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
 #include <sys/statvfs.h>
 #include <unistd.h>
 
@@ -115,7 +125,13 @@ long long get_monotonicTimeUSec()
 namespace Cpu {
 	vector<long long> core_old_totals;
 	vector<long long> core_old_idles;
-	vector<fs::path> core_freq;
+
+	//* Kept open scaling_cur_freq file of a core, read with pread() every update
+	struct core_freq_file {
+		int core;
+		FileFd file;
+	};
+	vector<core_freq_file> core_freq;
 	vector<string> available_fields = {"Auto", "total"};
 	vector<string> available_sensors = {"Auto"};
 	cpu_info current_cpu;
@@ -276,6 +292,7 @@ namespace Mem {
 namespace Shared {
 
 	fs::path procPath, passwd_path;
+	Tools::DirFd procDir;
 	long pageSize, clkTck, coreCount;
 
 	void init() {
@@ -285,6 +302,10 @@ namespace Shared {
 		if (procPath.empty())
 			throw std::runtime_error("Proc filesystem not found or no permission to read from it!");
 
+		procDir = Tools::DirFd(procPath);
+		if (not procDir)
+			throw std::runtime_error("Failed to open /proc directory!");
+
 		passwd_path = (fs::is_regular_file(fs::path("/etc/passwd")) and access("/etc/passwd", R_OK) != -1) ? "/etc/passwd" : "";
 		if (passwd_path.empty())
 			Logger::warning("Could not read /etc/passwd, will show UID instead of username.");
@@ -310,18 +331,26 @@ namespace Shared {
 			Logger::warning("Could not get system clock ticks per second. Defaulting to 100, processes cpu usage might be incorrect.");
 		}
 
+		update_tick();
+
 		//? Init for namespace Cpu
 		Cpu::current_cpu.core_percent.insert(Cpu::current_cpu.core_percent.begin(), Shared::coreCount, {});
 		Cpu::current_cpu.temp.insert(Cpu::current_cpu.temp.begin(), Shared::coreCount + 1, {});
 		Cpu::core_old_totals.insert(Cpu::core_old_totals.begin(), Shared::coreCount, 0);
 		Cpu::core_old_idles.insert(Cpu::core_old_idles.begin(), Shared::coreCount, 0);
 
+		Cpu::current_cpu.core_freq_max.assign(Shared::coreCount, 0);
 		for (int i = 0; i < Shared::coreCount; ++i) {
-			Cpu::core_freq.push_back("/sys/devices/system/cpu/cpufreq/policy" + to_string(i) + "/scaling_cur_freq");
-			if (not fs::exists(Cpu::core_freq.back()) or access(Cpu::core_freq.back().c_str(), R_OK) == -1) {
-				Cpu::core_freq.pop_back();
+			const auto freq_dir = fmt::format("/sys/devices/system/cpu/cpu{}/cpufreq/", i);
+			FileFd file(AT_FDCWD, (freq_dir + "scaling_cur_freq").c_str());
+			if (not file) continue;
+			if (auto buf = read_at(AT_FDCWD, (freq_dir + "cpuinfo_max_freq").c_str(), 0, true); buf.has_value()) {
+				long long max_khz{};
+				if (FieldScanner(*buf).next(max_khz)) Cpu::current_cpu.core_freq_max[i] = max_khz / 1000;
 			}
+			Cpu::core_freq.push_back({i, std::move(file)});
 		}
+		Cpu::has_core_freq = not Cpu::core_freq.empty();
 
 		Cpu::collect();
 		if (Runner::coreNum_reset) Runner::coreNum_reset = false;
@@ -371,11 +400,132 @@ namespace Shared {
 	#endif
 
 		//? Init for namespace Mem
-		Mem::old_uptime = system_uptime();
+		Mem::old_uptime = tick.uptime;
 		Mem::collect();
 
 		Logger::debug("Shared::init() : Initialized.");
 	}
+
+	auto cgroup_dir(const fs::path& root, const string& name) -> fs::path {
+		if (name.empty()) return {};
+		const fs::path path = name;
+		const bool inside_root = path.is_absolute() and std::mismatch(root.begin(), root.end(), path.begin(), path.end()).first == root.end();
+		const fs::path dir = inside_root ? path : root / path.relative_path();
+		std::error_code ec;
+		return fs::is_directory(dir, ec) ? dir.lexically_normal() : fs::path{};
+	}
+
+	bool read_cgroup_pids(const fs::path& dir, vector<size_t>& pids) {
+		auto buf = read_at(AT_FDCWD, (dir / "cgroup.procs").c_str());
+		if (not buf.has_value()) return false;
+		FieldScanner procs(*buf);
+		for (size_t pid{}; procs.next(pid);) pids.push_back(pid);
+
+		std::error_code ec;
+		for (fs::directory_iterator it(dir, ec), end; not ec and it != end; it.increment(ec)) {
+			if (it->is_directory(ec)) read_cgroup_pids(it->path(), pids);
+		}
+		return true;
+	}
+
+	bool read_cgroup_stats(const fs::path& dir, cgroup_stats& stats) {
+		stats = {};
+		bool found{};
+		if (auto buf = read_at(AT_FDCWD, (dir / "cpu.stat").c_str(), 0, true); buf.has_value()) {
+			found = true;
+			for (FieldScanner cpu_stat(*buf); not cpu_stat.empty();) {
+				FieldScanner line(cpu_stat.line());
+				const auto key = line.next();
+				if (key == "usage_usec") line.next(stats.usage_usec);
+				else if (key == "nr_throttled") line.next(stats.nr_throttled);
+				else if (key == "throttled_usec") line.next(stats.throttled_usec);
+			}
+		}
+		if (auto buf = read_at(AT_FDCWD, (dir / "memory.current").c_str(), 0, true); buf.has_value()) {
+			found = true;
+			FieldScanner(*buf).next(stats.mem_current);
+		}
+		//? "max" if unlimited, which leaves the limit at 0
+		if (auto buf = read_at(AT_FDCWD, (dir / "memory.max").c_str(), 0, true); buf.has_value()) {
+			found = true;
+			FieldScanner(*buf).next(stats.mem_max);
+		}
+		//? One line per device: "8:0 rbytes=1024 wbytes=0 rios=1 wios=0 dbytes=0 dios=0"
+		if (auto buf = read_at(AT_FDCWD, (dir / "io.stat").c_str()); buf.has_value()) {
+			found = stats.has_io = true;
+			for (FieldScanner io_stat(*buf); not io_stat.empty();) {
+				FieldScanner line(io_stat.line());
+				line.skip();
+				for (auto field = line.next(); not field.empty(); field = line.next()) {
+					uint64_t value{};
+					if (field.starts_with("rbytes=") and FieldScanner(field.substr(7)).next(value)) stats.io_read += value;
+					else if (field.starts_with("wbytes=") and FieldScanner(field.substr(7)).next(value)) stats.io_write += value;
+				}
+			}
+		}
+		return found;
+	}
+
+	auto cgroup_root() -> const fs::path& {
+		static const fs::path root = [] {
+			//? Usually /sys/fs/cgroup or /sys/fs/cgroup/unified on hybrid setups
+			if (auto buf = read_at(Shared::procDir.get(), "self/mounts"); buf.has_value()) {
+				for (FieldScanner mounts(*buf); not mounts.empty();) {
+					FieldScanner line(mounts.line());
+					line.skip();
+					const auto mount_point = line.next();
+					if (line.next() == "cgroup2") return fs::path(mount_point);
+				}
+			}
+			return fs::path("/sys/fs/cgroup");
+		}();
+		return root;
+	}
+
+	auto selected_cgroup() -> const fs::path& {
+		static string selected;
+		static fs::path dir;
+		//? A cgroup entered from the cgroup view takes precedence over proc_cgroup and isn't saved
+		const auto& scope = Config::getS("proc_cgroup_scope");
+		const auto& name = (scope.empty() ? Config::getS("proc_cgroup") : scope);
+		if (name == selected) return dir;
+		selected = name;
+
+		dir = cgroup_dir(cgroup_root(), name);
+		if (not name.empty() and dir.empty())
+			Logger::warning("Cgroup {} not found below {}, showing all processes.", name, cgroup_root().string());
+		return dir;
+	}
+
+	void update_tick() {
+		//? The files are kept open and read with pread() into the same buffers every update, reopened if procPath changes
+		static fs::path opened_path;
+		static FileFd stat_fd, meminfo_fd, uptime_fd;
+		if (opened_path != procPath) {
+			opened_path = procPath;
+			stat_fd = FileFd(procDir.get(), "stat");
+			meminfo_fd = FileFd(procDir.get(), "meminfo");
+			uptime_fd = FileFd(procDir.get(), "uptime");
+		}
+
+		tick.time_us = time_micros();
+		if (auto buf = uptime_fd.read(0, true); not buf.has_value() or not FieldScanner(*buf).next(tick.uptime))
+			tick.uptime = system_uptime();
+
+		if (auto buf = stat_fd.read(0, true); buf.has_value())
+			tick.stat.assign(*buf);
+		else
+			throw std::runtime_error("Failed to read /proc/stat");
+
+		tick.total_mem = 0;
+		if (auto buf = meminfo_fd.read(0, true); buf.has_value()) {
+			tick.meminfo.assign(*buf);
+			if (auto value = find_key(tick.meminfo, "MemTotal"); value.has_value() and FieldScanner(*value).next(tick.total_mem))
+				tick.total_mem <<= 10;
+		}
+		else
+			tick.meminfo.clear();
+	}
 }
 
 namespace Cpu {
@@ -384,25 +534,16 @@ namespace Cpu {
 	bool has_battery = true;
 	tuple<int, float, long, string> current_bat;
 
-	const array time_names {
-		"user"s, "nice"s, "system"s, "idle"s, "iowait"s,
-		"irq"s, "softirq"s, "steal"s, "guest"s, "guest_nice"s
+	//* Series of cpu_info::cpu_percent for the time fields of a cpu line in /proc/stat, in file order
+	constexpr array time_fields {
+		cpu_field::user, cpu_field::nice, cpu_field::system, cpu_field::idle, cpu_field::iowait,
+		cpu_field::irq, cpu_field::softirq, cpu_field::steal, cpu_field::guest, cpu_field::guest_nice
 	};
 
-	std::unordered_map<string, long long> cpu_old = {
-			{"totals", 0},
-			{"idles", 0},
-			{"user", 0},
-			{"nice", 0},
-			{"system", 0},
-			{"idle", 0},
-			{"iowait", 0},
-			{"irq", 0},
-			{"softirq", 0},
-			{"steal", 0},
-			{"guest", 0},
-			{"guest_nice", 0}
-	};
+	//? Totals and time fields of the previous update, for calculating cpu_info::cpu_percent
+	long long old_totals{};
+	long long old_idles{};
+	array<long long, time_fields.size()> old_times{};
 
 	string get_cpuName() {
 		string name;
@@ -576,7 +717,7 @@ namespace Cpu {
 		found_sensors.at(cpu_sensor).temp = stol(readfile(found_sensors.at(cpu_sensor).path, "0")) / 1000;
 		current_cpu.temp.at(0).push_back(found_sensors.at(cpu_sensor).temp);
 		current_cpu.temp_max = found_sensors.at(cpu_sensor).crit;
-		if (current_cpu.temp.at(0).size() > 20) current_cpu.temp.at(0).pop_front();
+		current_cpu.temp.at(0).set_capacity(20);
 
 		if (Config::getB("show_coretemp") and not cpu_temp_only) {
 			for (vector<string_view> done; const auto& sensor : core_sensors) {
@@ -587,7 +728,7 @@ namespace Cpu {
 			for (const auto& [core, temp] : core_mapping) {
 				if (cmp_less(core + 1, current_cpu.temp.size()) and cmp_less(temp, core_sensors.size())) {
 					current_cpu.temp.at(core + 1).push_back(found_sensors.at(core_sensors.at(temp)).temp);
-					if (current_cpu.temp.at(core + 1).size() > 20) current_cpu.temp.at(core + 1).pop_front();
+					current_cpu.temp.at(core + 1).set_capacity(20);
 				}
 			}
 		}
@@ -622,49 +763,50 @@ namespace Cpu {
 		string cpuhz;
 
 		const auto &freq_mode = Config::getS("freq_mode");
+		const bool per_core = Config::getB("show_core_freq");
 
 		try {
 			double hz = 0.0;
-			// Read frequencies from all CPU cores
-			vector<double> frequencies;
+			//? Read frequencies from the kept open scaling_cur_freq files, only the first core is needed
+			//? for freq_mode "first" unless the frequency of each core is shown
+			auto& core_mhz = current_cpu.core_freq;
+			core_mhz.assign(per_core ? Shared::coreCount : 0, 0);
+			double first{}, sum{}, lowest{}, highest{};
+			size_t count{};
 			for (auto it = Cpu::core_freq.begin(); it != Cpu::core_freq.end(); ) {
-    			if (it->empty()) {
-        			it = Cpu::core_freq.erase(it);
-        			continue;
-    			}
-
-    			double core_hz = stod(readfile(*it, "0.0")) / 1000;
-    			if (core_hz <= 0.0 and ++failed >= 2) {
-        			it = Cpu::core_freq.erase(it);
-    			} else {
-        			frequencies.push_back(core_hz);
-        			if (freq_mode == "first") break;
-        			++it;
-    			}
- 			}
+				long long core_khz{};
+				if (auto buf = it->file.read(0, true); buf.has_value()) FieldScanner(*buf).next(core_khz);
+				const double core_hz = core_khz / 1000.0;
+				if (core_hz <= 0.0 and ++failed >= 2) {
+					it = Cpu::core_freq.erase(it);
+					continue;
+				}
+				if (per_core and cmp_less(it->core, core_mhz.size())) core_mhz[it->core] = core_khz / 1000;
+				if (count++ == 0) first = lowest = highest = core_hz;
+				sum += core_hz;
+				lowest = min(lowest, core_hz);
+				highest = max(highest, core_hz);
+				if (freq_mode == "first" and not per_core) break;
+				++it;
+			}
+			has_core_freq = not Cpu::core_freq.empty();
 
-			if (not frequencies.empty()) {
+			if (count > 0) {
 				if (freq_mode == "first") {
-					hz = frequencies.front();
+					hz = first;
 				}
 				if (freq_mode == "average") {
-					hz = std::accumulate(frequencies.begin(), frequencies.end(), 0.0) / static_cast<double>(frequencies.size());
+					hz = sum / static_cast<double>(count);
 				}
 				else if (freq_mode == "highest") {
-					hz = *std::max_element(frequencies.begin(), frequencies.end());
+					hz = highest;
 				}
 				else if (freq_mode == "lowest") {
-					hz = *std::min_element(frequencies.begin(), frequencies.end());
+					hz = lowest;
 				}
 				else if (freq_mode == "range") {
-					auto [min_hz,max_hz] = std::minmax_element(frequencies.begin(), frequencies.end());
-
 					// Format as range
-					string min_str, max_str;
-					min_str = normalize_frequency(*min_hz);
-					max_str = normalize_frequency(*max_hz);
-
-					return min_str + " - " + max_str;
+					return normalize_frequency(lowest) + " - " + normalize_frequency(highest);
 				}
 			}
 			//? If freq from /sys failed or is missing try to use /proc/cpuinfo
@@ -1045,28 +1187,55 @@ namespace Cpu {
                std::views::join | std::ranges::to<std::vector<std::int32_t>>();
     }
 
+	bool parse_cpu_stat_line(string_view line, cpu_stat_line& out) {
+		//? Fields are separated by spaces, <pos> is moved past each parsed field
+		const char* pos = line.data();
+		const char* const end = line.data() + line.size();
+		while (pos < end and *pos != ' ') pos++;
+		out.core = -1;
+		if (pos - line.data() > 3 and std::from_chars(line.data() + 3, pos, out.core).ptr != pos) return false;
+
+		//? Expected on kernel 2.6.3> : 0=user, 1=nice, 2=system, 3=idle, 4=iowait, 5=irq, 6=softirq, 7=steal, 8=guest, 9=guest_nice
+		//? Counted in locals, stores to <out> could alias the parsed characters and keep the compiler from holding them in registers
+		size_t count = 0;
+		long long total = 0;
+		for (;; count++) {
+			while (pos < end and *pos == ' ') pos++;
+			long long val{};
+			const auto [ptr, ec] = std::from_chars(pos, end, val);
+			if (ec != std::errc{}) break;
+			pos = ptr;
+			if (count < out.fields.size()) out.fields[count] = val;
+			//? guest and guest_nice and any future fields are not added to the total
+			if (count < 8) total += val;
+		}
+		if (count < 4) return false;
+		out.count = count;
+		out.total = total;
+		out.idle = out.fields[3] + (count > 4 ? out.fields[4] : 0);
+		return true;
+	}
+
 	auto collect(bool no_update) -> cpu_info& {
-		if (Runner::stopping or (no_update and not current_cpu.cpu_percent.at("total").empty())) return current_cpu;
+		if (Runner::stopping or (no_update and not current_cpu.cpu_percent[cpu_field::total].empty())) return current_cpu;
 		auto& cpu = current_cpu;
 
-		if (Config::getB("show_cpu_freq"))
+		if (Config::getB("show_cpu_freq") or Config::getB("show_core_freq"))
 			cpuHz = get_cpuHz();
 
 		if (getloadavg(cpu.load_avg.data(), cpu.load_avg.size()) < 0) {
 			Logger::error("failed to get load averages");
 		}
 
-		ifstream cread;
-
 		try {
-			//? Get cpu total times for all cores from /proc/stat
-			string cpu_name;
-			cread.open(Shared::procPath / "stat");
+			//? Get cpu total times for all cores from the /proc/stat snapshot of this update
+			FieldScanner stat(Shared::tick.stat);
+			cpu_stat_line times;
 			int i = 0;
 			int target = Shared::coreCount;
-			for (; i <= target or (cread.good() and cread.peek() == 'c'); i++) {
+			for (; i <= target or stat.rest().starts_with("cpu"); i++) {
 				//? Make sure to add zero value for missing core values if at end of file
-				if ((not cread.good() or cread.peek() != 'c') and i <= target) {
+				if (not stat.rest().starts_with("cpu") and i <= target) {
 					if (i == 0) throw std::runtime_error("Failed to parse /proc/stat");
 					else {
 						//? Fix container sizes if new cores are detected
@@ -1079,11 +1248,11 @@ namespace Cpu {
 					}
 				}
 				else {
-					if (i == 0) cread.ignore(SSmax, ' ');
-					else {
-						cread >> cpu_name;
-						int cpuNum = std::stoi(cpu_name.substr(3));
-						if (cpuNum >= target - 1) target = cpuNum + (cread.peek() == 'c' ? 2 : 1);
+					if (not parse_cpu_stat_line(stat.line(), times) or (i > 0 and times.core < 0))
+						throw std::runtime_error("Malformed /proc/stat");
+					if (i > 0) {
+						const int cpuNum = times.core;
+						if (cpuNum >= target - 1) target = cpuNum + 1;
 
 						//? Add zero value for core if core number is missing from /proc/stat
 						while (i - 1 < cpuNum) {
@@ -1094,49 +1263,37 @@ namespace Cpu {
 								cpu.core_percent.emplace_back();
 							}
 							cpu.core_percent[i-1].push_back(0);
-							if (cpu.core_percent.at(i-1).size() > 40) cpu.core_percent.at(i-1).pop_front();
+							cpu.core_percent.at(i-1).set_capacity(40);
 							i++;
 						}
 					}
 
-					//? Expected on kernel 2.6.3> : 0=user, 1=nice, 2=system, 3=idle, 4=iowait, 5=irq, 6=softirq, 7=steal, 8=guest, 9=guest_nice
-					vector<long long> times;
-					long long total_sum = 0;
-
-					for (uint64_t val; cread >> val; total_sum += val) {
-						times.push_back(val);
-					}
-					cread.clear();
-					if (times.size() < 4) throw std::runtime_error("Malformed /proc/stat");
-
-					//? Subtract fields 8-9 and any future unknown fields
-					const long long totals = max(0ll, total_sum - (times.size() > 8 ? std::accumulate(times.begin() + 8, times.end(), 0ll) : 0));
-
-					//? Add iowait field if present
-					const long long idles = max(0ll, times.at(3) + (times.size() > 4 ? times.at(4) : 0));
+					const long long totals = max(0ll, times.total);
+					const long long idles = max(0ll, times.idle);
 
 					//? Calculate values for totals from first line of stat
 					if (i == 0) {
-						const long long calc_totals = max(1ll, totals - cpu_old.at("totals"));
-						const long long calc_idles = max(0ll, idles - cpu_old.at("idles"));
-						cpu_old.at("totals") = totals;
-						cpu_old.at("idles") = idles;
+						const long long calc_totals = max(1ll, totals - old_totals);
+						const long long calc_idles = max(0ll, idles - old_idles);
+						old_totals = totals;
+						old_idles = idles;
 
 						//? Total usage of cpu
-						cpu.cpu_percent.at("total").push_back(clamp((long long)round((double)(calc_totals - calc_idles) * 100 / calc_totals), 0ll, 100ll));
+						auto& total = cpu.cpu_percent[cpu_field::total];
+						total.push_back(clamp((long long)round((double)(calc_totals - calc_idles) * 100 / calc_totals), 0ll, 100ll));
 
 						//? Reduce size if there are more values than needed for graph
-						while (cmp_greater(cpu.cpu_percent.at("total").size(), width * 2)) cpu.cpu_percent.at("total").pop_front();
+						total.set_capacity(width * 2);
 
 						//? Populate cpu.cpu_percent with all fields from stat
-						for (int ii = 0; const auto& val : times) {
-							cpu.cpu_percent.at(time_names.at(ii)).push_back(clamp((long long)round((double)(val - cpu_old.at(time_names.at(ii))) * 100 / calc_totals), 0ll, 100ll));
-							cpu_old.at(time_names.at(ii)) = val;
+						for (size_t ii = 0; ii < min(times.count, time_fields.size()); ii++) {
+							const long long val = times.fields[ii];
+							auto& field = cpu.cpu_percent[time_fields[ii]];
+							field.push_back(clamp((long long)round((double)(val - old_times[ii]) * 100 / calc_totals), 0ll, 100ll));
+							old_times[ii] = val;
 
 							//? Reduce size if there are more values than needed for graph
-							while (cmp_greater(cpu.cpu_percent.at(time_names.at(ii)).size(), width * 2)) cpu.cpu_percent.at(time_names.at(ii)).pop_front();
-
-							if (++ii == 10) break;
+							field.set_capacity(width * 2);
 						}
 						continue;
 					}
@@ -1158,7 +1315,7 @@ namespace Cpu {
 				}
 
 				//? Reduce size if there are more values than needed for graph
-				if (cpu.core_percent.at(i-1).size() > 40) cpu.core_percent.at(i-1).pop_front();
+				cpu.core_percent.at(i-1).set_capacity(40);
 			}
 
 			//? Notify main thread to redraw screen if we found more cores than previously detected
@@ -1172,8 +1329,7 @@ namespace Cpu {
 		}
 		catch (const std::exception& e) {
 			Logger::debug("Cpu::collect() : {}", e.what());
-			if (cread.bad()) throw std::runtime_error("Failed to read /proc/stat");
-			else throw std::runtime_error(fmt::format("Cpu::collect() : {}", e.what()));
+			throw std::runtime_error(fmt::format("Cpu::collect() : {}", e.what()));
 		}
 
 		if (Config::getB("check_temp") and got_sensors)
@@ -1187,6 +1343,21 @@ namespace Cpu {
 
 		cpu.active_cpus = std::make_optional(detect_active_cpus());
 
+		//? Cpu usage of the cgroup selected with proc_cgroup as percent of all cores, from the second read
+		static fs::path cgroup_last;
+		static uint64_t cgroup_usage{}, cgroup_read_us{};
+		cpu.cgroup_percent = -1;
+		if (const auto& cgroup = Shared::selected_cgroup(); cgroup.empty())
+			cgroup_last.clear();
+		else if (Shared::cgroup_stats stats; Shared::read_cgroup_stats(cgroup, stats)) {
+			const auto now = time_micros();
+			if (cgroup == cgroup_last and now > cgroup_read_us)
+				cpu.cgroup_percent = clamp((stats.usage_usec - min(stats.usage_usec, cgroup_usage)) * 100.0 / ((now - cgroup_read_us) * Shared::coreCount), 0.0, 100.0);
+			cgroup_last = cgroup;
+			cgroup_usage = stats.usage_usec;
+			cgroup_read_us = now;
+		}
+
 		return cpu;
 	}
 }
@@ -1364,7 +1535,7 @@ namespace Gpu {
 						if constexpr(is_init) gpus_slice[i].supported_functions.gpu_utilization = false;
 						if constexpr(is_init) gpus_slice[i].supported_functions.mem_utilization = false;
     				} else {
-						gpus_slice[i].gpu_percent.at("gpu-totals").push_back((long long)utilization.gpu);
+						gpus_slice[i].gpu_percent[gpu_field::totals].push_back((long long)utilization.gpu);
 						gpus_slice[i].mem_utilization_percent.push_back((long long)utilization.memory);
     				}
 				}
@@ -1401,7 +1572,7 @@ namespace Gpu {
     					gpus_slice[i].pwr_usage = (long long)power;
 						if (gpus_slice[i].pwr_usage > gpus_slice[i].pwr_max_usage)
 								gpus_slice[i].pwr_max_usage = gpus_slice[i].pwr_usage;
-    					gpus_slice[i].gpu_percent.at("gpu-pwr-totals").push_back(clamp((long long)round((double)gpus_slice[i].pwr_usage * 100.0 / (double)gpus_slice[i].pwr_max_usage), 0ll, 100ll));
+    					gpus_slice[i].gpu_percent[gpu_field::pwr_totals].push_back(clamp((long long)round((double)gpus_slice[i].pwr_usage * 100.0 / (double)gpus_slice[i].pwr_max_usage), 0ll, 100ll));
     				}
     			}
 
@@ -1442,7 +1613,7 @@ namespace Gpu {
 						//gpu.mem_free = memory.free;
 
 						auto used_percent = (long long)round((double)memory.used * 100.0 / (double)memory.total);
-						gpus_slice[i].gpu_percent.at("gpu-vram-totals").push_back(used_percent);
+						gpus_slice[i].gpu_percent[gpu_field::vram_totals].push_back(used_percent);
 					}
 				}
 
@@ -1656,7 +1827,7 @@ namespace Gpu {
     				if (result != RSMI_STATUS_SUCCESS) {
 						Logger::warning("ROCm SMI: Failed to get GPU utilization");
 						if constexpr(is_init) gpus_slice[i].supported_functions.gpu_utilization = false;
-    				} else gpus_slice[i].gpu_percent.at("gpu-totals").push_back((long long)utilization);
+    				} else gpus_slice[i].gpu_percent[gpu_field::totals].push_back((long long)utilization);
 				}
 
 				//? Memory utilization
@@ -1739,7 +1910,7 @@ namespace Gpu {
 							gpus_slice[i].pwr_usage = (long long)power / 1000;
 							if (gpus_slice[i].pwr_usage > gpus_slice[i].pwr_max_usage)
 								gpus_slice[i].pwr_max_usage = gpus_slice[i].pwr_usage;
-							gpus_slice[i].gpu_percent.at("gpu-pwr-totals").push_back(clamp((long long)round((double)gpus_slice[i].pwr_usage * 100.0 / (double)gpus_slice[i].pwr_max_usage), 0ll, 100ll));
+							gpus_slice[i].gpu_percent[gpu_field::pwr_totals].push_back(clamp((long long)round((double)gpus_slice[i].pwr_usage * 100.0 / (double)gpus_slice[i].pwr_max_usage), 0ll, 100ll));
 						}
 
 					if constexpr(is_init) gpus_slice[i].supported_functions.pwr_state = false;
@@ -1776,7 +1947,7 @@ namespace Gpu {
 					} else {
 						gpus_slice[i].mem_used = used;
 						if (gpus_slice[i].supported_functions.mem_total)
-							gpus_slice[i].gpu_percent.at("gpu-vram-totals").push_back((long long)round((double)used * 100.0 / (double)gpus_slice[i].mem_total));
+							gpus_slice[i].gpu_percent[gpu_field::vram_totals].push_back((long long)round((double)used * 100.0 / (double)gpus_slice[i].mem_total));
 					}
 				}
 
@@ -1897,14 +2068,14 @@ namespace Gpu {
 					max_util = util;
 				}
 			}
-			gpus_slice->gpu_percent.at("gpu-totals").push_back((long long)round(max_util));
+			gpus_slice->gpu_percent[gpu_field::totals].push_back((long long)round(max_util));
 
 			double pwr = pmu_calc(&engines->r_gpu.val, 1, t, engines->r_gpu.scale); // in Watts
 			gpus_slice->pwr_usage = (long long)round(pwr * 1000);
 			if (gpus_slice->pwr_usage > gpus_slice->pwr_max_usage)
 				gpus_slice->pwr_max_usage = gpus_slice->pwr_usage;
 
-			gpus_slice->gpu_percent.at("gpu-pwr-totals").push_back(clamp((long long)round((double)gpus_slice->pwr_usage * 100.0 / (double)gpus_slice->pwr_max_usage), 0ll, 100ll));
+			gpus_slice->gpu_percent[gpu_field::pwr_totals].push_back(clamp((long long)round((double)gpus_slice->pwr_usage * 100.0 / (double)gpus_slice->pwr_max_usage), 0ll, 100ll));
 
 			double freq = pmu_calc(&engines->freq_act.val, 1, t, 1); // in MHz
 			gpus_slice->gpu_clock_speed = (unsigned int)round(freq);
@@ -1931,7 +2102,7 @@ namespace Gpu {
 		long long pwr_total = 0;
 		for (auto& gpu : gpus) {
 			if (gpu.supported_functions.gpu_utilization)
-				avg += gpu.gpu_percent.at("gpu-totals").back();
+				avg += gpu.gpu_percent[gpu_field::totals].back();
 			if (gpu.supported_functions.mem_used)
 				mem_usage_total += gpu.mem_used;
 			if (gpu.supported_functions.mem_total)
@@ -1942,27 +2113,27 @@ namespace Gpu {
 			//* Trim vectors if there are more values than needed for graphs
 			if (width != 0) {
 				//? GPU & memory utilization
-				while (cmp_greater(gpu.gpu_percent.at("gpu-totals").size(), width * 2)) gpu.gpu_percent.at("gpu-totals").pop_front();
-				while (cmp_greater(gpu.mem_utilization_percent.size(), width)) gpu.mem_utilization_percent.pop_front();
+				gpu.gpu_percent[gpu_field::totals].set_capacity(width * 2);
+				gpu.mem_utilization_percent.set_capacity(width);
 				//? Power usage
-				while (cmp_greater(gpu.gpu_percent.at("gpu-pwr-totals").size(), width)) gpu.gpu_percent.at("gpu-pwr-totals").pop_front();
+				gpu.gpu_percent[gpu_field::pwr_totals].set_capacity(width);
 				//? Temperature
-				while (cmp_greater(gpu.temp.size(), 18)) gpu.temp.pop_front();
+				gpu.temp.set_capacity(18);
 				//? Memory usage
-				while (cmp_greater(gpu.gpu_percent.at("gpu-vram-totals").size(), width/2)) gpu.gpu_percent.at("gpu-vram-totals").pop_front();
+				gpu.gpu_percent[gpu_field::vram_totals].set_capacity(width/2);
 			}
 		}
 
-		shared_gpu_percent.at("gpu-average").push_back(avg / gpus.size());
+		shared_gpu_percent[shared_field::average].push_back(avg / gpus.size());
 		if (mem_total != 0)
-			shared_gpu_percent.at("gpu-vram-total").push_back(mem_usage_total / mem_total);
+			shared_gpu_percent[shared_field::vram_total].push_back(mem_usage_total / mem_total);
 		if (gpu_pwr_total_max != 0)
-			shared_gpu_percent.at("gpu-pwr-total").push_back(pwr_total / gpu_pwr_total_max);
+			shared_gpu_percent[shared_field::pwr_total].push_back(pwr_total / gpu_pwr_total_max);
 
 		if (width != 0) {
-			while (cmp_greater(shared_gpu_percent.at("gpu-average").size(), width * 2)) shared_gpu_percent.at("gpu-average").pop_front();
-			while (cmp_greater(shared_gpu_percent.at("gpu-pwr-total").size(), width * 2)) shared_gpu_percent.at("gpu-pwr-total").pop_front();
-			while (cmp_greater(shared_gpu_percent.at("gpu-vram-total").size(), width * 2)) shared_gpu_percent.at("gpu-vram-total").pop_front();
+			shared_gpu_percent[shared_field::average].set_capacity(width * 2);
+			shared_gpu_percent[shared_field::pwr_total].set_capacity(width * 2);
+			shared_gpu_percent[shared_field::vram_total].set_capacity(width * 2);
 		}
 
 		count = gpus.size();
@@ -2018,21 +2189,20 @@ namespace Mem {
 	mem_info current_mem {};
 
 	uint64_t get_totalMem() {
-		ifstream meminfo(Shared::procPath / "meminfo");
-		int64_t totalMem = 0;
-		if (meminfo.good()) {
-			meminfo.ignore(SSmax, ':');
-			meminfo >> totalMem;
-			totalMem <<= 10;
-		}
-		if (not meminfo.good() or totalMem == 0)
+		if (Shared::tick.total_mem > 0) return Shared::tick.total_mem;
+		uint64_t totalMem = 0;
+		if (auto buf = read_at(Shared::procDir.get(), "meminfo", 0, true); buf.has_value()) {
+			if (auto value = find_key(*buf, "MemTotal"); value.has_value() and FieldScanner(*value).next(totalMem))
+				totalMem <<= 10;
+		}
+		if (totalMem == 0)
 			throw std::runtime_error("Could not get total memory size from /proc/meminfo");
 
 		return totalMem;
 	}
 
 	auto collect(bool no_update) -> mem_info& {
-		if (Runner::stopping or (no_update and not current_mem.percent.at("used").empty())) return current_mem;
+		if (Runner::stopping or (no_update and not current_mem.percent[mem_field::used].empty())) return current_mem;
 		auto show_swap = Config::getB("show_swap");
 		auto swap_disk = Config::getB("swap_disk");
 		auto show_disks = Config::getB("show_disks");
@@ -2040,92 +2210,96 @@ namespace Mem {
 		auto totalMem = get_totalMem();
 		auto& mem = current_mem;
 
-		mem.stats.at("swap_total") = 0;
+		mem.stats[mem_field::swap_total] = 0;
 
 		//? Read ZFS ARC info from /proc/spl/kstat/zfs/arcstats
 		uint64_t arc_size = 0, arc_min_size = 0;
 		if (zfs_arc_cached) {
-			ifstream arcstats(Shared::procPath / "spl/kstat/zfs/arcstats");
-			if (arcstats.good()) {
-				for (string label; arcstats >> label;) {
+			if (auto buf = read_at(Shared::procDir.get(), "spl/kstat/zfs/arcstats"); buf.has_value()) {
+				for (FieldScanner arcstats(*buf); not arcstats.empty();) {
+					FieldScanner line(arcstats.line());
+					const auto label = line.next();
 					if (label == "c_min") {
-						arcstats >> arc_min_size >> arc_min_size; // double read skips type column
+						line.skip().next(arc_min_size); // skip type column
 					}
 					else if (label == "size") {
-						arcstats >> arc_size >> arc_size;
+						line.skip().next(arc_size);
 						break;
 					}
 				}
 			}
-			arcstats.close();
 		}
 
-		//? Read memory info from /proc/meminfo
-		ifstream meminfo(Shared::procPath / "meminfo");
-		if (meminfo.good()) {
+		//? Read memory info from the /proc/meminfo snapshot of this update
+		if (const auto& buf = Shared::tick.meminfo; not buf.empty()) {
 			bool got_avail = false;
-			for (string label; meminfo.peek() != 'D' and meminfo >> label;) {
+			auto read_kb = [](FieldScanner& line, uint64_t& value) {
+				if (line.next(value)) value <<= 10;
+			};
+			for (FieldScanner meminfo(buf); not meminfo.empty() and meminfo.rest().front() != 'D';) {
+				FieldScanner line(meminfo.line());
+				const auto label = line.next();
 				if (label == "MemFree:") {
-					meminfo >> mem.stats.at("free");
-					mem.stats.at("free") <<= 10;
+					read_kb(line, mem.stats[mem_field::free]);
 				}
 				else if (label == "MemAvailable:") {
-					meminfo >> mem.stats.at("available");
-					mem.stats.at("available") <<= 10;
+					read_kb(line, mem.stats[mem_field::available]);
 					got_avail = true;
 				}
 				else if (label == "Cached:") {
-					meminfo >> mem.stats.at("cached");
-					mem.stats.at("cached") <<= 10;
+					read_kb(line, mem.stats[mem_field::cached]);
 					if (not show_swap and not swap_disk) break;
 				}
 				else if (label == "SwapTotal:") {
-					meminfo >> mem.stats.at("swap_total");
-					mem.stats.at("swap_total") <<= 10;
+					read_kb(line, mem.stats[mem_field::swap_total]);
 				}
 				else if (label == "SwapFree:") {
-					meminfo >> mem.stats.at("swap_free");
-					mem.stats.at("swap_free") <<= 10;
+					read_kb(line, mem.stats[mem_field::swap_free]);
 					break;
 				}
-				meminfo.ignore(SSmax, '\n');
 			}
-			if (not got_avail) mem.stats.at("available") = mem.stats.at("free") + mem.stats.at("cached");
+			if (not got_avail) mem.stats[mem_field::available] = mem.stats[mem_field::free] + mem.stats[mem_field::cached];
 			if (zfs_arc_cached) {
-				mem.stats.at("cached") += arc_size;
+				mem.stats[mem_field::cached] += arc_size;
 				// The ARC will not shrink below arc_min_size, so that memory is not available
 				if (arc_size > arc_min_size)
-					mem.stats.at("available") += arc_size - arc_min_size;
+					mem.stats[mem_field::available] += arc_size - arc_min_size;
 			}
-			mem.stats.at("used") = totalMem - (mem.stats.at("available") <= totalMem ? mem.stats.at("available") : mem.stats.at("free"));
+			mem.stats[mem_field::used] = totalMem - (mem.stats[mem_field::available] <= totalMem ? mem.stats[mem_field::available] : mem.stats[mem_field::free]);
 
-			if (mem.stats.at("swap_total") > 0) mem.stats.at("swap_used") = mem.stats.at("swap_total") - mem.stats.at("swap_free");
+			if (mem.stats[mem_field::swap_total] > 0) mem.stats[mem_field::swap_used] = mem.stats[mem_field::swap_total] - mem.stats[mem_field::swap_free];
 		}
 		else
 			throw std::runtime_error("Failed to read /proc/meminfo");
 
-		meminfo.close();
-
 		//? Calculate percentages
-		for (const auto& name : mem_names) {
-			mem.percent.at(name).push_back(round((double)mem.stats.at(name) * 100 / totalMem));
-			while (cmp_greater(mem.percent.at(name).size(), width * 2)) mem.percent.at(name).pop_front();
+		for (const auto field : {mem_field::used, mem_field::available, mem_field::cached, mem_field::free}) {
+			auto& percent = mem.percent[field];
+			percent.push_back(round((double)mem.stats[field] * 100 / totalMem));
+			percent.set_capacity(width * 2);
 		}
 
-		if (show_swap and mem.stats.at("swap_total") > 0) {
-			for (const auto& name : swap_names) {
-				mem.percent.at(name).push_back(round((double)mem.stats.at(name) * 100 / mem.stats.at("swap_total")));
-				while (cmp_greater(mem.percent.at(name).size(), width * 2)) mem.percent.at(name).pop_front();
+		if (show_swap and mem.stats[mem_field::swap_total] > 0) {
+			for (const auto field : {mem_field::swap_used, mem_field::swap_free}) {
+				auto& percent = mem.percent[field];
+				percent.push_back(round((double)mem.stats[field] * 100 / mem.stats[mem_field::swap_total]));
+				percent.set_capacity(width * 2);
 			}
 			has_swap = true;
 		}
 		else
 			has_swap = false;
 
+		//? Memory use and limit of the cgroup selected with proc_cgroup
+		Shared::cgroup_stats cgroup_stats;
+		mem.cgroup = not Shared::selected_cgroup().empty() and Shared::read_cgroup_stats(Shared::selected_cgroup(), cgroup_stats);
+		mem.cgroup_current = cgroup_stats.mem_current;
+		mem.cgroup_max = cgroup_stats.mem_max;
+
 		//? Get disks stats
 		if (show_disks) {
 			static vector<string> ignore_list;
-			double uptime = system_uptime();
+			double uptime = Shared::tick.uptime;
 			auto free_priv = Config::getB("disk_free_priv");
 			try {
 				auto& disks_filter = Config::getS("disks_filter");
@@ -2337,11 +2511,11 @@ namespace Mem {
 				if (swap_disk and has_swap) {
 					mem.disks_order.push_back("swap");
 					if (not disks.contains("swap")) disks["swap"] = {"", "swap", "swap"};
-					disks.at("swap").total = mem.stats.at("swap_total");
-					disks.at("swap").used = mem.stats.at("swap_used");
-					disks.at("swap").free = mem.stats.at("swap_free");
-					disks.at("swap").used_percent = mem.percent.at("swap_used").back();
-					disks.at("swap").free_percent = mem.percent.at("swap_free").back();
+					disks.at("swap").total = mem.stats[mem_field::swap_total];
+					disks.at("swap").used = mem.stats[mem_field::swap_used];
+					disks.at("swap").free = mem.stats[mem_field::swap_free];
+					disks.at("swap").used_percent = mem.percent[mem_field::swap_used].back();
+					disks.at("swap").free_percent = mem.percent[mem_field::swap_free].back();
 				}
 				for (const auto& name : last_found)
 					#ifdef SNAPPED
@@ -2351,7 +2525,7 @@ namespace Mem {
 					#endif
 
 				//? Get disks IO
-				int64_t sectors_read, sectors_write, io_ticks, io_ticks_temp;
+				int64_t sectors_read{}, sectors_write{}, io_ticks{}, io_ticks_temp{};
 				disk_ios = 0;
 				for (auto& [ignored, disk] : disks) {
 					if (disk.stat.empty() or access(disk.stat.c_str(), R_OK) != 0) continue;
@@ -2359,11 +2533,14 @@ namespace Mem {
 						disk_ios++;
 						continue;
 					}
-					diskread.open(disk.stat);
-					if (diskread.good()) {
+					//? ZFS Pool Support
+					const bool is_zfs = disk.fstype == "zfs";
+					std::optional<string_view> stat_buf;
+					if (is_zfs) diskread.open(disk.stat);
+					else stat_buf = read_at(AT_FDCWD, disk.stat.c_str(), 0, true);
+					if (is_zfs ? diskread.good() : stat_buf.has_value()) {
 						disk_ios++;
-						//? ZFS Pool Support
-						if (disk.fstype == "zfs") {
+						if (is_zfs) {
 							// skip first three lines
 							for (int i = 0; i < 3; i++) diskread.ignore(numeric_limits<streamsize>::max(), '\n');
 							// skip characters until '4' is reached, indicating data type 4, next value will be out target
@@ -2378,7 +2555,7 @@ namespace Mem {
 							else
 								disk.io_write.push_back(max((int64_t)0, (sectors_write - disk.old_io.at(1))));
 							disk.old_io.at(1) = sectors_write;
-							while (cmp_greater(disk.io_write.size(), width * 2)) disk.io_write.pop_front();
+							disk.io_write.set_capacity(width * 2);
 
 							// skip characters until '4' is reached, indicating data type 4, next value will be out target
 							diskread.ignore(numeric_limits<streamsize>::max(), '4');
@@ -2393,41 +2570,39 @@ namespace Mem {
 							else
 								disk.io_read.push_back(max((int64_t)0, (sectors_read - disk.old_io.at(0))));
 							disk.old_io.at(0) = sectors_read;
-							while (cmp_greater(disk.io_read.size(), width * 2)) disk.io_read.pop_front();
+							disk.io_read.set_capacity(width * 2);
 
 							if (disk.io_activity.empty())
 								disk.io_activity.push_back(0);
 							else
 								disk.io_activity.push_back(max((int64_t)0, (io_ticks - disk.old_io.at(2))));
 							disk.old_io.at(2) = io_ticks;
-							while (cmp_greater(disk.io_activity.size(), width * 2)) disk.io_activity.pop_front();
+							disk.io_activity.set_capacity(width * 2);
 						} else {
-							for (int i = 0; i < 2; i++) { diskread >> std::ws; diskread.ignore(SSmax, ' '); }
-							diskread >> sectors_read;
+							FieldScanner stat(*stat_buf);
+							stat.skip(2).next(sectors_read);
 							if (disk.io_read.empty())
 								disk.io_read.push_back(0);
 							else
 								disk.io_read.push_back(max((int64_t)0, (sectors_read - disk.old_io.at(0)) * 512));
 							disk.old_io.at(0) = sectors_read;
-							while (cmp_greater(disk.io_read.size(), width * 2)) disk.io_read.pop_front();
+							disk.io_read.set_capacity(width * 2);
 
-							for (int i = 0; i < 3; i++) { diskread >> std::ws; diskread.ignore(SSmax, ' '); }
-							diskread >> sectors_write;
+							stat.skip(3).next(sectors_write);
 							if (disk.io_write.empty())
 								disk.io_write.push_back(0);
 							else
 								disk.io_write.push_back(max((int64_t)0, (sectors_write - disk.old_io.at(1)) * 512));
 							disk.old_io.at(1) = sectors_write;
-							while (cmp_greater(disk.io_write.size(), width * 2)) disk.io_write.pop_front();
+							disk.io_write.set_capacity(width * 2);
 
-							for (int i = 0; i < 2; i++) { diskread >> std::ws; diskread.ignore(SSmax, ' '); }
-							diskread >> io_ticks;
+							stat.skip(2).next(io_ticks);
 							if (uptime == old_uptime || disk.io_activity.empty())
 								disk.io_activity.push_back(0);
 							else
 								disk.io_activity.push_back(clamp((long)round((double)(io_ticks - disk.old_io.at(2)) / (uptime - old_uptime) / 10), 0l, 100l));
 							disk.old_io.at(2) = io_ticks;
-							while (cmp_greater(disk.io_activity.size(), width * 2)) disk.io_activity.pop_front();
+							disk.io_activity.set_capacity(width * 2);
 						}
 					} else {
 						Logger::debug("Error in Mem::collect() : when opening {}", disk.stat);
@@ -2557,21 +2732,21 @@ namespace Mem {
 		else
 			disk.io_write.push_back(max((int64_t)0, (bytes_write_total - disk.old_io.at(1))));
 		disk.old_io.at(1) = bytes_write_total;
-		while (cmp_greater(disk.io_write.size(), width * 2)) disk.io_write.pop_front();
+		disk.io_write.set_capacity(width * 2);
 
 		if (disk.io_read.empty())
 			disk.io_read.push_back(0);
 		else
 			disk.io_read.push_back(max((int64_t)0, (bytes_read_total - disk.old_io.at(0))));
 		disk.old_io.at(0) = bytes_read_total;
-		while (cmp_greater(disk.io_read.size(), width * 2)) disk.io_read.pop_front();
+		disk.io_read.set_capacity(width * 2);
 
 		if (disk.io_activity.empty())
 			disk.io_activity.push_back(0);
 		else
 			disk.io_activity.push_back(max((int64_t)0, (io_ticks_total - disk.old_io.at(2))));
 		disk.old_io.at(2) = io_ticks_total;
-		while (cmp_greater(disk.io_activity.size(), width * 2)) disk.io_activity.pop_front();
+		disk.io_activity.set_capacity(width * 2);
 
 		return true;
 	}
@@ -2584,8 +2759,8 @@ namespace Net {
 	vector<string> interfaces;
 	string selected_iface;
 	int errors{};
-	std::unordered_map<string, uint64_t> graph_max = { {"download", {}}, {"upload", {}} };
-	std::unordered_map<string, array<int, 2>> max_count = { {"download", {}}, {"upload", {}} };
+	direction_map<uint64_t> graph_max;
+	direction_map<array<int, 2>> max_count;
 	bool rescale{true};
 	uint64_t timestamp{};
 
@@ -2662,15 +2837,14 @@ namespace Net {
 				if (netif.ipv4.empty() and netif.ipv6.empty())
 					netif.ipv4 = readfile("/sys/class/net/" + iface + "/address");
 
-				for (const string dir : {"download", "upload"}) {
-					const fs::path sys_file = "/sys/class/net/" + iface + "/statistics/" + (dir == "download" ? "rx_bytes" : "tx_bytes");
-					auto& saved_stat = netif.stat.at(dir);
-					auto& bandwidth = netif.bandwidth.at(dir);
+				for (const auto dir : {direction::download, direction::upload}) {
+					const auto sys_file = fmt::format("/sys/class/net/{}/statistics/{}", iface, (dir == direction::download ? "rx_bytes" : "tx_bytes"));
+					auto& saved_stat = netif.stat[dir];
+					auto& bandwidth = netif.bandwidth[dir];
 
 					uint64_t val{};
-					try { val = stoull(readfile(sys_file, "0")); }
-					catch (const std::invalid_argument&) {}
-					catch (const std::out_of_range&) {}
+					if (auto buf = read_at(AT_FDCWD, sys_file.c_str(), 0, true); buf.has_value())
+						FieldScanner(*buf).next(val);
 
 					//? Update speed, total and top values
 					if (val < saved_stat.last) {
@@ -2689,11 +2863,11 @@ namespace Net {
 
 					//? Add values to graph
 					bandwidth.push_back(saved_stat.speed);
-					while (cmp_greater(bandwidth.size(), width * 2)) bandwidth.pop_front();
+					bandwidth.set_capacity(width * 2);
 
 					//? Set counters for auto scaling
 					if (net_auto and selected_iface == iface) {
-						if (net_sync and saved_stat.speed < netif.stat.at(dir == "download" ? "upload" : "download").speed) continue;
+						if (net_sync and saved_stat.speed < netif.stat[dir == direction::download ? direction::upload : direction::download].speed) continue;
 						if (saved_stat.speed > graph_max[dir]) {
 							++max_count[dir][0];
 							if (max_count[dir][1] > 0) --max_count[dir][1];
@@ -2726,7 +2900,7 @@ namespace Net {
 
 		//? Find an interface to display if selected isn't set or valid
 		if (selected_iface.empty() or not v_contains(interfaces, selected_iface)) {
-			max_count["download"][0] = max_count["download"][1] = max_count["upload"][0] = max_count["upload"][1] = 0;
+			max_count[direction::download] = max_count[direction::upload] = {};
 			redraw = true;
 			if (net_auto) rescale = true;
 			if (not config_iface.empty() and v_contains(interfaces, config_iface)) selected_iface = config_iface;
@@ -2734,8 +2908,8 @@ namespace Net {
 				//? Sort interfaces by total upload + download bytes
 				auto sorted_interfaces = interfaces;
 				rng::sort(sorted_interfaces, [&](const auto& a, const auto& b){
-					return 	cmp_greater(net.at(a).stat["download"].total + net.at(a).stat["upload"].total,
-										net.at(b).stat["download"].total + net.at(b).stat["upload"].total);
+					return 	cmp_greater(net.at(a).stat[direction::download].total + net.at(a).stat[direction::upload].total,
+										net.at(b).stat[direction::download].total + net.at(b).stat[direction::upload].total);
 				});
 				selected_iface.clear();
 				//? Try to set to a connected interface
@@ -2755,12 +2929,13 @@ namespace Net {
 		//? Calculate max scale for graphs if needed
 		if (net_auto) {
 			bool sync = false;
-			for (const auto& dir: {"download", "upload"}) {
+			for (const auto dir : {direction::download, direction::upload}) {
 				for (const auto& sel : {0, 1}) {
 					if (rescale or max_count[dir][sel] >= 5) {
-						const long long avg_speed = (net[selected_iface].bandwidth[dir].size() > 5
-							? std::accumulate(net.at(selected_iface).bandwidth.at(dir).rbegin(), net.at(selected_iface).bandwidth.at(dir).rbegin() + 5, 0ll) / 5
-							: net[selected_iface].stat[dir].speed);
+						const auto& selected = net[selected_iface];
+						const long long avg_speed = (selected.bandwidth[dir].size() > 5
+							? std::accumulate(selected.bandwidth[dir].rbegin(), selected.bandwidth[dir].rbegin() + 5, 0ll) / 5
+							: selected.stat[dir].speed);
 						graph_max[dir] = max(uint64_t(avg_speed * (sel == 0 ? 1.3 : 3.0)), (uint64_t)10 << 10);
 						max_count[dir][0] = max_count[dir][1] = 0;
 						redraw = true;
@@ -2770,7 +2945,7 @@ namespace Net {
 				}
 				//? Sync download/upload graphs if enabled
 				if (sync) {
-					const auto other = (string(dir) == "upload" ? "download" : "upload");
+					const auto other = (dir == direction::upload ? direction::download : direction::upload);
 					graph_max[other] = graph_max[dir];
 					max_count[other][0] = max_count[other][1] = 0;
 					break;
@@ -2786,7 +2961,6 @@ namespace Net {
 namespace Proc {
 
 	vector<proc_info> current_procs;
-	std::unordered_map<string, string> uid_user;
 	string current_sort;
 	string current_filter;
 	bool current_rev{};
@@ -2801,28 +2975,653 @@ namespace Proc {
 	int filter_found{};
 
 	detail_container detailed;
-	constexpr size_t KTHREADD = 2;
-	static std::unordered_set<size_t> kernels_procs = {KTHREADD};
+	//? Set in the flags field of /proc/[pid]/stat for kernel threads
+	constexpr uint64_t PF_KTHREAD = 0x00200000;
+
+	//? Kernel threads hidden by proc_filter_kernel, by pid with the start time to tell a reused pid apart
+	struct kernel_thread {
+		uint64_t starttime{};
+		uint64_t seen_gen{};
+	};
+	static std::unordered_map<size_t, kernel_thread> kernel_threads;
 	static std::unordered_set<size_t> dead_procs;
 
-	//* Get detailed info for selected process
-	static void _collect_details(const size_t pid, const uint64_t uptime, vector<proc_info>& procs) {
-		fs::path pid_path = Shared::procPath / std::to_string(pid);
+	//? Maps pid to its slot in current_procs, rebuilt whenever current_procs is reordered
+	static std::unordered_map<size_t, size_t> pid_index;
+
+	//? Incremented every collection pass, processes stamped with the current value was seen during this pass
+	static uint64_t collect_gen{};
+
+	//* Rebuild the pid to slot index after current_procs has been reordered or resized
+	//* Existing entries are updated in place so only new pids cause an allocation
+	static void reindex() {
+		for (size_t i = 0; i < current_procs.size(); i++)
+			pid_index.insert_or_assign(current_procs[i].pid, i);
+		std::erase_if(pid_index, [](const auto& entry) {
+			return entry.second >= current_procs.size() or current_procs[entry.second].pid != entry.first;
+		});
+	}
+
+	struct DirCloser {
+		void operator()(DIR* dir) const noexcept { closedir(dir); }
+	};
+
+	//* Return "<pid>/<file>" as a path relative to Shared::procDir, valid until the next call from the same thread
+	static auto pid_file(const size_t pid, const std::string_view file) -> const char* {
+		thread_local array<char, 64> path;
+		*fmt::format_to_n(path.data(), path.size() - 1, "{}/{}", pid, file).out = '\0';
+		return path.data();
+	}
+
+	//* Return pointer to process with pid <pid> in current_procs or nullptr if not found
+	static auto find_proc(const size_t pid) -> proc_info* {
+		auto it = pid_index.find(pid);
+		return (it != pid_index.end() and it->second < current_procs.size() and current_procs[it->second].pid == pid)
+			? &current_procs[it->second] : nullptr;
+	}
+
+	//? Process claimed for parsing during a collection pass, results are merged in the order pids were found
+	struct proc_job {
+		size_t slot{};
+		bool no_cache{};
+		bool got_uid{};
+		bool kernel{};
+		bool parsed{};
+		uid_t uid{};
+	};
+	static vector<proc_job> proc_jobs;
+	static WorkerPool proc_workers;
+
+	//? Values shared read-only between workers during a collection pass
+	struct parse_context {
+		uint64_t totalMem;
+		double uptime;
+		int cmult;
+		bool should_filter_kernel;
+		bool sample_waiters;
+		uint64_t now_us;
+	};
+
+	//? With the "top waiters" sorting the run queue wait of every process is read once every <waiters_interval> updates
+	constexpr size_t waiters_interval = 5;
+
+	//* Return run queue wait in nanoseconds, the second field of a /proc/[pid]/schedstat buffer
+	static auto _parse_schedstat(std::optional<string_view> buf) -> std::optional<uint64_t> {
+		if (uint64_t wait_ns{}; buf.has_value() and FieldScanner(*buf).skip().next(wait_ns)) return wait_ns;
+		return std::nullopt;
+	}
+
+	//* Parse /proc/[pid] files for the process in <job>
+	//* Only touches current_procs[job.slot] and <job>, which makes it safe to run different jobs in parallel
+	static void _parse_proc(proc_job& job, const parse_context& ctx) {
+		auto& new_proc = current_procs[job.slot];
+		const auto pid = new_proc.pid;
+
+		//? Parse /proc/[pid]/stat
+		auto buf = read_at(Shared::procDir.get(), pid_file(pid, "stat"), 0, true);
+		if (not buf.has_value()) return;
+
+		pid_stat stat;
+		if (not parse_pid_stat(*buf, stat)) return;
+		const uint64_t cpu_t = stat.utime + stat.stime;
+
+		//? A changed start time means the pid was reused by a new process, drop everything cached for the old one
+		if (new_proc.cpu_s != 0 and new_proc.cpu_s != stat.starttime) {
+			new_proc.cpu_s = 0;
+			new_proc.short_cmd.clear();
+			new_proc.collapsed = false;
+			new_proc.wait_read_us = 0;
+			new_proc.wait_p = -1;
+			job.no_cache = true;
+		}
+
+		//? Get cpu seconds if missing
+		if (new_proc.cpu_s == 0) {
+			new_proc.cpu_t = cpu_t;
+			new_proc.cpu_s = stat.starttime;
+			new_proc.cputimes_read = cputimes;
+		}
+
+		new_proc.state = stat.state;
+		new_proc.ppid = stat.ppid;
+		new_proc.p_nice = stat.nice;
+		new_proc.threads = stat.threads;
+
+		//? Kernel threads have no command line and always run as root, hidden ones need nothing more than the start time
+		const bool is_kernel = stat.flags & PF_KTHREAD;
+		if (is_kernel and ctx.should_filter_kernel) {
+			job.kernel = true;
+			job.parsed = true;
+			return;
+		}
+
+		//? RSS memory (can be inaccurate, but parsing smaps increases total cpu usage by ~20x)
+		new_proc.mem = (stat.rss > ctx.totalMem / Shared::pageSize ? ctx.totalMem : stat.rss * Shared::pageSize);
+
+		//? Get RSS memory from /proc/[pid]/statm if value from /proc/[pid]/stat looks wrong
+		if (new_proc.mem >= ctx.totalMem) {
+			buf = read_at(Shared::procDir.get(), pid_file(pid, "statm"), 0, true);
+			if (not buf.has_value() or not FieldScanner(*buf).skip().next(new_proc.mem)) return;
+			new_proc.mem *= Shared::pageSize;
+		}
+
+		//? Process cpu usage since last read, which is more than one update back for idle processes that were skipped
+		new_proc.cpu_p = clamp(round(ctx.cmult * 1000 * (cpu_t - new_proc.cpu_t) / max((uint64_t)1, cputimes - new_proc.cputimes_read)) / 10.0, 0.0, 100.0 * Shared::coreCount);
+
+		//? Process cumulative cpu usage since process start
+		new_proc.cpu_c = (double)cpu_t / max(1.0, (ctx.uptime * Shared::clkTck) - new_proc.cpu_s);
 
+		//? Page fault rates from the counters in stat, over the same interval as the cpu usage
+		if (cputimes > new_proc.cputimes_read) {
+			const double seconds = (double)(cputimes - new_proc.cputimes_read) / (Shared::clkTck * Shared::coreCount);
+			new_proc.minflt_rate = (stat.minflt - min(stat.minflt, new_proc.minflt)) / seconds;
+			new_proc.majflt_rate = (stat.majflt - min(stat.majflt, new_proc.majflt)) / seconds;
+		}
+		new_proc.minflt = stat.minflt;
+		new_proc.majflt = stat.majflt;
+
+		//? Run queue wait for the "top waiters" sorting, spread over pids to bound the number of extra reads per update
+		if (ctx.sample_waiters and (pid + collect_gen) % waiters_interval == 0) {
+			if (auto wait_ns = _parse_schedstat(read_at(Shared::procDir.get(), pid_file(pid, "schedstat"), 0, true)); wait_ns.has_value()) {
+				if (new_proc.wait_read_us != 0 and ctx.now_us > new_proc.wait_read_us)
+					new_proc.wait_p = clamp((*wait_ns - min(*wait_ns, new_proc.wait_ns)) / ((ctx.now_us - new_proc.wait_read_us) * 10.0), 0.0, 100.0 * Shared::coreCount);
+				new_proc.wait_ns = *wait_ns;
+				new_proc.wait_read_us = ctx.now_us;
+			}
+		}
+
+		//? Update cached value with latest cpu times
+		new_proc.cpu_t = cpu_t;
+		new_proc.cputimes_read = cputimes;
+
+		//? Get program name, command and uid only for new processes, after exec() or when refresh is due, the username is resolved when merging
+		if (job.no_cache and is_kernel) {
+			new_proc.filter_gen = 0;
+			new_proc.name = InternedString(stat.name);
+			new_proc.cmd.clear();
+			job.uid = 0;
+			job.got_uid = true;
+		}
+		else if (job.no_cache) {
+			new_proc.filter_gen = 0;
+			buf = read_at(Shared::procDir.get(), pid_file(pid, "comm"), 0, true);
+			if (not buf.has_value()) return;
+			new_proc.name = InternedString(buf->substr(0, buf->find('\n')));
+
+			buf = read_at(Shared::procDir.get(), pid_file(pid, "cmdline"), 1001, true);
+			if (not buf.has_value()) return;
+			new_proc.cmd = *buf;
+			rng::replace(new_proc.cmd, '\0', ' ');
+			if (new_proc.cmd.size() > 1000) new_proc.cmd.resize(1000);
+			if (not new_proc.cmd.empty()) new_proc.cmd.pop_back();
+
+			buf = read_at(Shared::procDir.get(), pid_file(pid, "status"), 0, true);
+			if (not buf.has_value()) return;
+			if (auto uid_line = find_key(*buf, "Uid"); uid_line.has_value())
+				job.got_uid = FieldScanner(*uid_line).next(job.uid);
+		}
+
+		job.parsed = true;
+	}
+
+	//? Usernames by uid from /etc/passwd, completed by lookups through NSS on a background thread
+	static std::unordered_map<uid_t, InternedString> uid_user;
+
+	//? Uids waiting for a lookup and the names found, shared with the lookup thread which may outlive collect()
+	struct user_lookups {
+		std::mutex mtx;
+		vector<uid_t> pending;
+		vector<pair<uid_t, string>> resolved;
+		bool running{};
+	};
+	static const auto user_lookup_state = std::make_shared<user_lookups>();
+
+	//* Return username for <uid> through getpwuid_r(), or <uid> as text if not found
+	static string _lookup_user([[maybe_unused]] uid_t uid) {
+	#if !(defined(STATIC_BUILD) && defined(__GLIBC__))
+		const long buf_size = sysconf(_SC_GETPW_R_SIZE_MAX);
+		vector<char> buf(buf_size > 0 ? buf_size : 16384);
+		struct passwd pwd;
+		struct passwd* result{};
+		if (getpwuid_r(uid, &pwd, buf.data(), buf.size(), &result) == 0 and result != nullptr and result->pw_name != nullptr)
+			return result->pw_name;
+	#endif
+		return to_string(uid);
+	}
+
+	//* Queue <uid> for _lookup_user() on a background thread, NSS can block for a long time when backed by LDAP or SSSD
+	static void _queue_user_lookup(uid_t uid) {
+		const auto state = user_lookup_state;
+		std::lock_guard lock(state->mtx);
+		state->pending.push_back(uid);
+		if (state->running) return;
+		try {
+			std::thread([state] {
+				std::unique_lock lock(state->mtx);
+				while (not state->pending.empty()) {
+					const auto next = state->pending.back();
+					state->pending.pop_back();
+					lock.unlock();
+					auto name = _lookup_user(next);
+					lock.lock();
+					state->resolved.emplace_back(next, std::move(name));
+				}
+				state->running = false;
+			}).detach();
+			state->running = true;
+		}
+		catch (const std::system_error& e) {
+			state->pending.pop_back();
+			Logger::debug("Failed to start username lookup thread: {}", e.what());
+		}
+	}
+
+	//* Return username for <uid>, uids missing from /etc/passwd show as the uid until the background lookup finishes
+	static auto _get_user(uid_t uid) -> const InternedString& {
+		auto [user, inserted] = uid_user.try_emplace(uid);
+		if (inserted) {
+			user->second = to_string(uid);
+			_queue_user_lookup(uid);
+		}
+		return user->second;
+	}
+
+	//* Store names found by background lookups, processes that show the uid are updated, uids that failed stay cached as the uid
+	static void _apply_user_lookups() {
+		vector<pair<uid_t, string>> resolved;
+		{
+			std::lock_guard lock(user_lookup_state->mtx);
+			if (user_lookup_state->resolved.empty()) return;
+			resolved.swap(user_lookup_state->resolved);
+		}
+		for (const auto& [uid, name] : resolved) {
+			auto user = uid_user.find(uid);
+			if (user == uid_user.end() or user->second != to_string(uid) or name == user->second) continue;
+			const auto placeholder = std::exchange(user->second, InternedString{name});
+			for (auto& p : current_procs) {
+				if (p.user == placeholder) {
+					p.user = user->second;
+					p.filter_gen = 0;
+				}
+			}
+		}
+	}
+
+	//* Fill uid_user from the "name:password:uid:..." lines of <passwd>, the first entry for a uid is used
+	static void _parse_passwd(string_view passwd) {
+		while (not passwd.empty()) {
+			const auto line = passwd.substr(0, passwd.find('\n'));
+			passwd.remove_prefix(std::min(passwd.size(), line.size() + 1));
+			const auto name_end = line.find(':');
+			const auto uid_start = line.find(':', name_end == string_view::npos ? name_end : name_end + 1);
+			if (name_end == 0 or uid_start == string_view::npos) continue;
+			uid_t uid{};
+			const auto uid_field = line.substr(uid_start + 1);
+			if (auto [ptr, ec] = std::from_chars(uid_field.data(), uid_field.data() + uid_field.size(), uid); ec != std::errc{} or ptr == uid_field.data() + uid_field.size() or *ptr != ':')
+				continue;
+			uid_user.try_emplace(uid, InternedString(line.substr(0, name_end)));
+		}
+	}
+
+	bool parse_pid_stat(string_view buf, pid_stat& out) {
+		//? The kernel limits the name to 64 characters, so only that part needs to be searched backwards for the closing ')'
+		const auto name_start = buf.find('(');
+		const auto name_end = buf.substr(0, name_start + 66).rfind(')');
+		if (name_start == string_view::npos or name_end == string_view::npos or name_end < name_start) return false;
+		out.name = buf.substr(name_start + 1, name_end - name_start - 1);
+
+		//? Fields after the name are separated by a single space, <pos> is kept at the space before the next field
+		const char* pos = buf.data() + name_end + 1;
+		const char* const end = buf.data() + buf.size();
+		auto skip = [&](int fields) {
+			while (fields-- > 0 and pos < end)
+				while (++pos < end and *pos != ' ');
+		};
+		auto next = [&](auto& value) {
+			if (pos >= end) return false;
+			auto [ptr, ec] = std::from_chars(pos + 1, end, value);
+			if (ec != std::errc{}) return false;
+			pos = ptr;
+			return true;
+		};
+
+		//? Fields are numbered as in proc(5), starting at 3 (state) after the name
+		if (end - pos < 3 or pos[0] != ' ') return false;
+		out.state = pos[1];
+		pos += 2;
+		if (not next(out.ppid) // 4
+		or (skip(4), not next(out.flags)) // 9
+		or not next(out.minflt) or (skip(1), not next(out.majflt)) // 10, 12
+		or (skip(1), not next(out.utime)) or not next(out.stime) // 14, 15
+		or (skip(2), not next(out.priority)) or not next(out.nice) // 18, 19
+		or not next(out.threads) or (skip(1), not next(out.starttime)) // 20, 22
+		or (skip(1), not next(out.rss))) // 24
+			return false;
+
+		//? Added in later kernels, missing fields are left as 0
+		skip(14);
+		if (next(out.processor) and next(out.rt_priority)) { // 39, 40
+			skip(1);
+			next(out.blkio_ticks); // 42
+		}
+		return true;
+	}
+
+	//? Snapshot of a process taken from the event listener thread
+	struct event_proc {
+		size_t pid{};
+		string name{};
+		string cmd{};
+		std::optional<uid_t> uid{};
+		uint64_t ppid{};
+		uint64_t cpu_t{};
+		uint64_t cpu_s{};
+		bool got_stat{};
+		bool kernel{};
+	};
+
+	//* Keeps the set of live pids up to date from fork/exec/exit events sent by the kernel process connector
+	//* Needs CAP_NET_ADMIN, collect() falls back to scanning /proc when start() fails or events were lost
+	class ProcEvents {
+		int sock{-1};
+		int stop_fd{-1};
+		std::thread listener;
+		std::mutex mtx;
+		std::unordered_set<size_t> live;
+		std::unordered_set<size_t> forks;
+		std::unordered_set<size_t> execs;
+		std::unordered_map<size_t, event_proc> exec_snapshots;
+		vector<event_proc> exited;
+		bool lost{true};
+
+		static constexpr size_t max_exited = 4096;
+
+		bool subscribe(proc_cn_mcast_op op) {
+			alignas(nlmsghdr) array<char, NLMSG_SPACE(sizeof(cn_msg) + sizeof(proc_cn_mcast_op))> buf{};
+			auto* nl_hdr = reinterpret_cast<nlmsghdr*>(buf.data());
+			nl_hdr->nlmsg_len = NLMSG_LENGTH(sizeof(cn_msg) + sizeof(proc_cn_mcast_op));
+			nl_hdr->nlmsg_type = NLMSG_DONE;
+			auto* cn_hdr = reinterpret_cast<cn_msg*>(NLMSG_DATA(nl_hdr));
+			cn_hdr->id = {CN_IDX_PROC, CN_VAL_PROC};
+			cn_hdr->len = sizeof(proc_cn_mcast_op);
+			std::memcpy(cn_hdr->data, &op, sizeof(op));
+			return send(sock, buf.data(), nl_hdr->nlmsg_len, 0) >= 0;
+		}
+
+		void on_exec(size_t pid) {
+			event_proc snapshot{pid};
+			if (auto buf = read_at(Shared::procDir.get(), pid_file(pid, "comm"), 0, true); buf.has_value())
+				snapshot.name = buf->substr(0, buf->find('\n'));
+			if (auto buf = read_at(Shared::procDir.get(), pid_file(pid, "cmdline"), 1000, true); buf.has_value()) {
+				snapshot.cmd = *buf;
+				rng::replace(snapshot.cmd, '\0', ' ');
+				if (not snapshot.cmd.empty()) snapshot.cmd.pop_back();
+			}
+			if (auto buf = read_at(Shared::procDir.get(), pid_file(pid, "status"), 0, true); buf.has_value()) {
+				if (auto uid_line = find_key(*buf, "Uid"); uid_line.has_value())
+					if (uid_t uid; FieldScanner(*uid_line).next(uid)) snapshot.uid = uid;
+			}
+			std::lock_guard lock(mtx);
+			execs.insert(pid);
+			exec_snapshots.insert_or_assign(pid, std::move(snapshot));
+		}
+
+		void on_exit(size_t pid) {
+			//? The process is a zombie at this point if the parent hasn't reaped it yet, so cpu times can still be read
+			event_proc snapshot{pid};
+			if (auto buf = read_at(Shared::procDir.get(), pid_file(pid, "stat"), 0, true); buf.has_value()) {
+				if (pid_stat stat; parse_pid_stat(*buf, stat)) {
+					snapshot.name = stat.name;
+					snapshot.ppid = stat.ppid;
+					snapshot.cpu_t = stat.utime + stat.stime;
+					snapshot.cpu_s = stat.starttime;
+					snapshot.kernel = stat.flags & PF_KTHREAD;
+					snapshot.got_stat = true;
+				}
+			}
+			std::lock_guard lock(mtx);
+			live.erase(pid);
+			execs.erase(pid);
+			if (auto node = exec_snapshots.extract(pid); not node.empty()) {
+				snapshot.cmd = std::move(node.mapped().cmd);
+				snapshot.uid = std::move(node.mapped().uid);
+				if (not snapshot.got_stat) snapshot.name = std::move(node.mapped().name);
+			}
+			if (exited.size() < max_exited) exited.push_back(std::move(snapshot));
+		}
+
+		void listen() {
+			alignas(nlmsghdr) array<char, 16384> buf;
+			array<pollfd, 2> fds = {{{sock, POLLIN, 0}, {stop_fd, POLLIN, 0}}};
+			while (true) {
+				if (poll(fds.data(), fds.size(), -1) < 0) {
+					if (errno == EINTR) continue;
+					break;
+				}
+				//? Woken by stop()
+				if (fds[1].revents != 0) return;
+
+				const ssize_t len = recv(sock, buf.data(), buf.size(), 0);
+				if (len < 0) {
+					//? ENOBUFS means the socket buffer overflowed and events were dropped
+					if (errno == ENOBUFS) {
+						std::lock_guard lock(mtx);
+						lost = true;
+					}
+					else if (not is_in(errno, EINTR, EAGAIN, EWOULDBLOCK)) break;
+					continue;
+				}
+
+				int remaining = len;
+				for (auto* nl_hdr = reinterpret_cast<nlmsghdr*>(buf.data()); NLMSG_OK(nl_hdr, remaining); nl_hdr = NLMSG_NEXT(nl_hdr, remaining)) {
+					if (is_in(nl_hdr->nlmsg_type, NLMSG_ERROR, NLMSG_OVERRUN)) {
+						std::lock_guard lock(mtx);
+						lost = true;
+						continue;
+					}
+					const auto* cn_hdr = reinterpret_cast<const cn_msg*>(NLMSG_DATA(nl_hdr));
+					if (cn_hdr->id.idx != CN_IDX_PROC or cn_hdr->id.val != CN_VAL_PROC) continue;
+					const auto* event = reinterpret_cast<const proc_event*>(cn_hdr->data);
+
+					//? Thread events are ignored, only events where pid == tgid concern a process
+					switch (event->what) {
+					case proc_event::PROC_EVENT_FORK:
+						if (event->event_data.fork.child_pid == event->event_data.fork.child_tgid) {
+							std::lock_guard lock(mtx);
+							live.insert(event->event_data.fork.child_tgid);
+							forks.insert(event->event_data.fork.child_tgid);
+						}
+						break;
+					case proc_event::PROC_EVENT_EXEC:
+						on_exec(event->event_data.exec.process_tgid);
+						break;
+					case proc_event::PROC_EVENT_COMM:
+						if (event->event_data.comm.process_pid == event->event_data.comm.process_tgid) {
+							std::lock_guard lock(mtx);
+							execs.insert(event->event_data.comm.process_tgid);
+						}
+						break;
+					case proc_event::PROC_EVENT_EXIT:
+						if (event->event_data.exit.process_pid == event->event_data.exit.process_tgid)
+							on_exit(event->event_data.exit.process_tgid);
+						break;
+					default:
+						break;
+					}
+				}
+			}
+			Logger::warning("Proc::ProcEvents : Listener stopped: {}, falling back to scanning /proc", strerror(errno));
+			std::lock_guard lock(mtx);
+			lost = true;
+		}
+
+	public:
+		ProcEvents() = default;
+		~ProcEvents() noexcept { stop(); }
+		ProcEvents(const ProcEvents& other) = delete;
+		ProcEvents& operator=(const ProcEvents& other) = delete;
+		ProcEvents(ProcEvents&& other) = delete;
+		ProcEvents& operator=(ProcEvents&& other) = delete;
+
+		[[nodiscard]] bool running() const noexcept { return sock >= 0; }
+
+		//* Open and subscribe to the process connector, returns false if not available or not permitted
+		bool start() {
+			if (running()) return true;
+			sock = socket(PF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC, NETLINK_CONNECTOR);
+			if (sock < 0) {
+				Logger::info("Proc::ProcEvents : Process connector not available: {}", strerror(errno));
+				return false;
+			}
+			sockaddr_nl addr{};
+			addr.nl_family = AF_NETLINK;
+			addr.nl_groups = CN_IDX_PROC;
+			addr.nl_pid = 0;
+			if (bind(sock, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 or not subscribe(PROC_CN_MCAST_LISTEN)) {
+				Logger::info("Proc::ProcEvents : Could not subscribe to process events (needs CAP_NET_ADMIN): {}", strerror(errno));
+				close(sock);
+				sock = -1;
+				return false;
+			}
+			//? Try to get a larger receive buffer to survive bursts of short-lived processes
+			const int rcvbuf = 4 << 20;
+			setsockopt(sock, SOL_SOCKET, SO_RCVBUFFORCE, &rcvbuf, sizeof(rcvbuf));
+
+			stop_fd = eventfd(0, EFD_CLOEXEC);
+			if (stop_fd < 0) {
+				subscribe(PROC_CN_MCAST_IGNORE);
+				close(sock);
+				sock = -1;
+				return false;
+			}
+			lost = true;
+			listener = std::thread(&ProcEvents::listen, this);
+			Logger::debug("Proc::ProcEvents : Listening for process events");
+			return true;
+		}
+
+		void stop() noexcept {
+			if (not running()) return;
+			const uint64_t one = 1;
+			if (write(stop_fd, &one, sizeof(one)) < 0) {}
+			if (listener.joinable()) listener.join();
+			subscribe(PROC_CN_MCAST_IGNORE);
+			close(sock);
+			close(stop_fd);
+			sock = stop_fd = -1;
+			std::lock_guard lock(mtx);
+			live.clear();
+			forks.clear();
+			execs.clear();
+			exec_snapshots.clear();
+			exited.clear();
+		}
+
+		//* Move pids that were forked or called exec() and processes that exited since last call into <fork_out>, <exec_out> and <exited_out>
+		//* Fills <pids_out> with all live pids and returns true, or returns false if /proc needs to be scanned instead
+		bool take(vector<size_t>& pids_out, std::unordered_set<size_t>& fork_out, std::unordered_set<size_t>& exec_out, vector<event_proc>& exited_out) {
+			std::lock_guard lock(mtx);
+			fork_out.clear();
+			std::swap(fork_out, forks);
+			exec_out.clear();
+			std::swap(exec_out, execs);
+			exited_out.clear();
+			std::swap(exited_out, exited);
+			exec_snapshots.clear();
+			if (lost or not running()) {
+				lost = false;
+				return false;
+			}
+			pids_out.assign(live.begin(), live.end());
+			return true;
+		}
+
+		//* Add pids found by a scan of /proc, pids that exited during the scan are removed later through forget()
+		void merge(const vector<size_t>& pids) {
+			std::lock_guard lock(mtx);
+			live.insert(pids.begin(), pids.end());
+		}
+
+		//* Remove a pid that could not be read anymore
+		void forget(size_t pid) {
+			std::lock_guard lock(mtx);
+			live.erase(pid);
+		}
+	};
+	static ProcEvents proc_events;
+	static vector<size_t> proc_pids;
+	static std::unordered_set<size_t> fork_pids;
+	static std::unordered_set<size_t> exec_pids;
+	static vector<event_proc> exited_procs;
+
+	//? Memory totals of a process in KiB, summed from smaps_rollup or smaps
+	struct smaps_totals {
+		uint64_t rss{};
+		uint64_t pss{};
+		uint64_t uss{};
+		uint64_t swap{};
+		uint64_t anon_huge{};
+	};
+
+	//* Add the memory fields in <buf> to <totals>, <buf> is either the single summary of smaps_rollup or one entry per mapping from smaps
+	static void _sum_smaps(string_view buf, smaps_totals& totals) {
+		for (FieldScanner smaps(buf); not smaps.empty();) {
+			auto line = smaps.line();
+			uint64_t* field{};
+			if (line.starts_with("Rss:")) field = &totals.rss;
+			else if (line.starts_with("Pss:")) field = &totals.pss;
+			else if (line.starts_with("Private_Clean:") or line.starts_with("Private_Dirty:")) field = &totals.uss;
+			else if (line.starts_with("Swap:")) field = &totals.swap;
+			else if (line.starts_with("AnonHugePages:")) field = &totals.anon_huge;
+			else continue;
+			if (uint64_t value{}; FieldScanner(line).skip().next(value)) *field += value;
+		}
+	}
+
+	//? Run queue wait of the detailed process, read through a file kept open while the process is shown
+	static FileFd detailed_schedstat;
+	static uint64_t detailed_wait_ns{}, detailed_wait_us{};
+
+	//* Get detailed info for selected process
+	static void _collect_details(const size_t pid, const uint64_t uptime) {
 		if (pid != detailed.last_pid) {
 			detailed = {};
 			detailed.last_pid = pid;
 			detailed.skip_smaps = not Config::getB("proc_info_smaps");
+			detailed_schedstat = FileFd(Shared::procDir.get(), pid_file(pid, "schedstat"));
+			detailed_wait_us = 0;
 		}
 
 		//? Copy proc_info for process from proc vector
-		auto p_info = rng::find(procs, pid, &proc_info::pid);
+		auto p_info = find_proc(pid);
+		if (p_info == nullptr) return;
 		detailed.entry = *p_info;
 
 		//? Update cpu percent deque for process cpu graph
 		if (not Config::getB("proc_per_core")) detailed.entry.cpu_p *= Shared::coreCount;
 		detailed.cpu_percent.push_back(clamp((long long)round(detailed.entry.cpu_p), 0ll, 100ll));
-		while (cmp_greater(detailed.cpu_percent.size(), width)) detailed.cpu_percent.pop_front();
+		detailed.cpu_percent.set_capacity(width);
+
+		//? Update page fault rate deque for the fault graph, the graph is rescaled when the peak leaves the current range
+		detailed.fault_rate.push_back(round(detailed.entry.minflt_rate + detailed.entry.majflt_rate));
+		detailed.fault_rate.set_capacity(width);
+		if (const auto peak = rng::max(detailed.fault_rate); detailed.fault_max == -1 or peak > detailed.fault_max or (detailed.fault_max > 100 and peak * 4 < detailed.fault_max)) {
+			detailed.fault_max = max(peak * 2, 100ll);
+			redraw = true;
+		}
+		detailed.faults = fmt::format("Maj:{}/s Min:{}/s", count_humanizer(detailed.entry.majflt_rate), count_humanizer(detailed.entry.minflt_rate));
+
+		//? Update run queue wait deque for the wait graph, which takes room from the cpu graph once there are values
+		if (auto wait_ns = _parse_schedstat(detailed_schedstat.read(0, true)); wait_ns.has_value()) {
+			const auto now = time_micros();
+			if (detailed_wait_us != 0 and now > detailed_wait_us) {
+				if (detailed.wait_percent.empty()) redraw = true;
+				detailed.wait_percent.push_back(clamp((long long)round((*wait_ns - min(*wait_ns, detailed_wait_ns)) / ((now - detailed_wait_us) * 10.0)), 0ll, 100ll));
+				detailed.wait_percent.set_capacity(width);
+			}
+			detailed_wait_ns = *wait_ns;
+			detailed_wait_us = now;
+		}
 
 		//? Process runtime
 		if (detailed.entry.state != 'X') detailed.elapsed = sec_to_dhms(uptime - (detailed.entry.cpu_s / Shared::clkTck));
@@ -2831,40 +3630,42 @@ namespace Proc {
 
 		//? Get parent process name
 		if (detailed.parent.empty()) {
-			auto p_entry = rng::find(procs, detailed.entry.ppid, &proc_info::pid);
-			if (p_entry != procs.end()) detailed.parent = p_entry->name;
+			if (auto p_entry = find_proc(detailed.entry.ppid); p_entry != nullptr) detailed.parent = p_entry->name;
 		}
 
 		//? Expand process status from single char to explanative string
 		detailed.status = (proc_states.contains(detailed.entry.state)) ? proc_states.at(detailed.entry.state) : "Unknown";
 
-		ifstream d_read;
-		string short_str;
-
-		//? Try to get RSS mem from proc/[pid]/smaps
+		//? Try to get RSS, PSS, USS, swap and huge pages from proc/[pid]/smaps_rollup, or from proc/[pid]/smaps on kernels older than 4.14
+		//? Smaps is summed on every update like smaps_rollup, PSS and USS can change while RSS stays the same
 		detailed.memory.clear();
-		if (not detailed.skip_smaps and fs::exists(pid_path / "smaps")) {
-			d_read.open(pid_path / "smaps");
-			uint64_t rss = 0;
-			try {
-				while (d_read.good()) {
-					d_read.ignore(SSmax, 'R');
-					if (d_read.peek() == 's') {
-						d_read.ignore(SSmax, ':');
-						getline(d_read, short_str, 'k');
-						rss += stoull(short_str);
-					}
+		detailed.mem_detail.clear();
+		if (not detailed.skip_smaps) {
+			smaps_totals totals;
+			bool got_smaps{};
+			if (auto buf = read_at(Shared::procDir.get(), pid_file(pid, "smaps_rollup")); buf.has_value()) {
+				_sum_smaps(*buf, totals);
+				got_smaps = true;
+			}
+			else if (buf = read_at(Shared::procDir.get(), pid_file(pid, "smaps")); buf.has_value()) {
+				_sum_smaps(*buf, totals);
+				got_smaps = true;
+			}
+
+			if (got_smaps) {
+				for (auto [series, value] : {pair{&detailed.pss_bytes, totals.pss}, {&detailed.uss_bytes, totals.uss}, {&detailed.swap_bytes, totals.swap}, {&detailed.anon_huge_bytes, totals.anon_huge}}) {
+					series->push_back(value << 10);
+					series->set_capacity(width);
 				}
-				if (rss == detailed.entry.mem >> 10)
-					detailed.skip_smaps = true;
-				else {
-					detailed.mem_bytes.push_back(rss << 10);
-					detailed.memory = floating_humanizer(rss, false, 1);
+				//? PSS and USS have their own graphs, swap and huge pages are shown after the memory value
+				detailed.mem_detail = fmt::format("Swap:{}", floating_humanizer(totals.swap, true, 1));
+				if (totals.anon_huge > 0) detailed.mem_detail += fmt::format(" Huge:{}", floating_humanizer(totals.anon_huge, true, 1));
+
+				if (totals.rss != detailed.entry.mem >> 10) {
+					detailed.mem_bytes.push_back(totals.rss << 10);
+					detailed.memory = floating_humanizer(totals.rss, false, 1);
 				}
 			}
-			catch (const std::invalid_argument&) {}
-			catch (const std::out_of_range&) {}
-			d_read.close();
 		}
 		if (detailed.memory.empty()) {
 			detailed.mem_bytes.push_back(detailed.entry.mem);
@@ -2875,43 +3676,474 @@ namespace Proc {
 			redraw = true;
 		}
 
-		while (cmp_greater(detailed.mem_bytes.size(), width)) detailed.mem_bytes.pop_front();
+		detailed.mem_bytes.set_capacity(width);
 
 		//? Get bytes read and written from proc/[pid]/io
-		if (fs::exists(pid_path / "io")) {
-			d_read.open(pid_path / "io");
-			try {
-				string name;
-				while (d_read.good()) {
-					getline(d_read, name, ':');
-					if (name.ends_with("read_bytes")) {
-						getline(d_read, short_str);
-						detailed.io_read = floating_humanizer(stoull(short_str));
+		if (auto buf = read_at(Shared::procDir.get(), pid_file(pid, "io"), 0, true); buf.has_value()) {
+			uint64_t value{};
+			if (auto read_bytes = find_key(*buf, "read_bytes"); read_bytes.has_value() and FieldScanner(*read_bytes).next(value))
+				detailed.io_read = floating_humanizer(value);
+			if (auto write_bytes = find_key(*buf, "write_bytes"); write_bytes.has_value() and FieldScanner(*write_bytes).next(value))
+				detailed.io_write = floating_humanizer(value);
+		}
+	}
+
+	//? Rows above and below the visible part of the list that the optional proc_columns are also read for
+	constexpr int columns_margin = 10;
+
+	//? Counters behind the optional proc_columns, kept for a while after a process scrolls out of view
+	struct proc_counters {
+		uint64_t read_us{};
+		uint64_t starttime{};
+		uint64_t io_read{};
+		uint64_t io_write{};
+		uint64_t wait_ns{};
+		uint64_t vctx{};
+		uint64_t nvctx{};
+		uint64_t pass{};   // last pass of _collect_columns that had the process in or near the visible rows
+		FileFd schedstat;  // kept open while the process stays in or near the visible rows
+		bool got_io{};
+		bool got_wait{};
+		bool got_ctx{};
+	};
+	static std::unordered_map<size_t, proc_counters> column_counters;
+	static uint64_t column_counters_pass{};
+	constexpr uint64_t column_counters_max_age = 10'000'000;
+
+	//* Return number of open file descriptors of <pid> or -1 if not readable
+	static int64_t _count_fds(const size_t pid) {
+		const int fd = openat(Shared::procDir.get(), pid_file(pid, "fd"), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+		if (fd < 0) return -1;
+		std::unique_ptr<DIR, DirCloser> dir(fdopendir(fd));
+		if (dir == nullptr) {
+			close(fd);
+			return -1;
+		}
+		int64_t count{};
+		while (const auto* d = readdir(dir.get()))
+			if (d->d_name[0] != '.') count++;
+		return count;
+	}
+
+	//* Read the values for the optional proc_columns of processes in or near the visible part of the list
+	//* Processes that already have cached counters are skipped when <no_update> is set, so scrolling only reads new rows
+	static void _collect_columns(const string& columns, bool tree, bool no_update) {
+		if (columns.empty()) {
+			column_counters.clear();
+			return;
+		}
+		const auto column_list = ssplit(columns);
+		const bool want_io = v_contains(column_list, "io_read") or v_contains(column_list, "io_write");
+		const bool want_fds = v_contains(column_list, "fds");
+		const bool want_wait = v_contains(column_list, "wait");
+		const bool want_ctx = v_contains(column_list, "ctx_vol") or v_contains(column_list, "ctx_invol");
+		if (not (want_io or want_fds or want_wait or want_ctx)) {
+			column_counters.clear();
+			return;
+		}
+		const auto now = time_micros();
+		const int first = Config::getI("proc_start") - columns_margin;
+		const int last = Config::getI("proc_start") + Proc::select_max + columns_margin;
+		const auto pass = ++column_counters_pass;
+
+		for (int row = 0; auto& p : current_procs) {
+			if (p.filtered or (tree and p.tree_index == current_procs.size())) continue;
+			if (row++ < first) continue;
+			if (row > last) break;
+			if (p.state == 'X') continue;
+
+			auto [entry, inserted] = column_counters.try_emplace(p.pid);
+			auto& counters = entry->second;
+			if (not inserted and counters.starttime != p.cpu_s) {
+				counters = {};
+				inserted = true;
+			}
+			counters.pass = pass;
+			if (no_update and not inserted) continue;
+			if (inserted) {
+				counters.starttime = p.cpu_s;
+				p.io_read_rate = p.io_write_rate = p.fds = -1;
+				p.wait_p = p.vctx_rate = p.nvctx_rate = -1;
+			}
+			const double elapsed = max((uint64_t)1, now - counters.read_us);
+			auto read_key = [](string_view buf, string_view key, uint64_t& value) {
+				auto line = find_key(buf, key);
+				return line.has_value() and FieldScanner(*line).next(value);
+			};
+
+			if (want_io) {
+				uint64_t io_read{}, io_write{};
+				auto buf = read_at(Shared::procDir.get(), pid_file(p.pid, "io"), 0, true);
+				if (buf.has_value() and read_key(*buf, "read_bytes", io_read) and read_key(*buf, "write_bytes", io_write)) {
+					if (counters.got_io) {
+						p.io_read_rate = round((io_read - min(io_read, counters.io_read)) * 1'000'000 / elapsed);
+						p.io_write_rate = round((io_write - min(io_write, counters.io_write)) * 1'000'000 / elapsed);
 					}
-					else if (name.ends_with("write_bytes")) {
-						getline(d_read, short_str);
-						detailed.io_write = floating_humanizer(stoull(short_str));
-						break;
+					counters.io_read = io_read;
+					counters.io_write = io_write;
+					counters.got_io = true;
+				}
+			}
+
+			if (want_fds) p.fds = _count_fds(p.pid);
+
+			if (want_wait) {
+				if (not counters.schedstat) counters.schedstat = FileFd(Shared::procDir.get(), pid_file(p.pid, "schedstat"));
+				if (auto wait_ns = _parse_schedstat(counters.schedstat.read(0, true)); wait_ns.has_value()) {
+					if (counters.got_wait) p.wait_p = clamp((*wait_ns - min(*wait_ns, counters.wait_ns)) / (elapsed * 10), 0.0, 100.0 * Shared::coreCount);
+					counters.wait_ns = *wait_ns;
+					counters.got_wait = true;
+				}
+			}
+
+			if (want_ctx) {
+				uint64_t vctx{}, nvctx{};
+				auto buf = read_at(Shared::procDir.get(), pid_file(p.pid, "status"), 0, true);
+				if (buf.has_value() and read_key(*buf, "voluntary_ctxt_switches", vctx) and read_key(*buf, "nonvoluntary_ctxt_switches", nvctx)) {
+					if (counters.got_ctx) {
+						p.vctx_rate = (vctx - min(vctx, counters.vctx)) * 1'000'000 / elapsed;
+						p.nvctx_rate = (nvctx - min(nvctx, counters.nvctx)) * 1'000'000 / elapsed;
 					}
-					else
-						d_read.ignore(SSmax, '\n');
+					counters.vctx = vctx;
+					counters.nvctx = nvctx;
+					counters.got_ctx = true;
+				}
+			}
+			counters.read_us = now;
+		}
+
+		//? Counters are kept for a while after a process leaves the rows, but its schedstat file is closed right away,
+		//? so scrolling through a long list doesn't pile up open files until the counters expire
+		for (auto it = column_counters.begin(); it != column_counters.end();) {
+			if (now - it->second.read_us > column_counters_max_age) {
+				it = column_counters.erase(it);
+				continue;
+			}
+			if (it->second.pass != pass) it->second.schedstat = {};
+			++it;
+		}
+	}
+
+	//? Counters of each cgroup from the last read of the cgroup view, for the rates
+	struct cgroup_counters {
+		uint64_t usage_usec{};
+		uint64_t throttled_usec{};
+		uint64_t io_read{};
+		uint64_t io_write{};
+		uint64_t read_us{};
+		bool has_io{};
+	};
+	static std::unordered_map<string, cgroup_counters> cgroup_history;
+
+	//* List all cgroups below the cgroup v2 mount in Proc::cgroups for the cgroup view
+	//* Each cgroup is read once from its own cpu.stat, memory.current and io.stat, processes are not read at all
+	static void _collect_cgroups(bool no_update) {
+		const auto& filter = Config::getS("proc_filter");
+		static string last_filter;
+		if (not no_update or cgroups.empty() or filter != last_filter) {
+			last_filter = filter;
+			const auto& root = Shared::cgroup_root();
+			const auto now = time_micros();
+			const double cores = Config::getB("proc_per_core") ? 1 : Shared::coreCount;
+			cgroups.clear();
+			std::unordered_map<string, cgroup_counters> history;
+			history.reserve(cgroup_history.size());
+
+			auto add = [&](const fs::path& dir) {
+				Shared::cgroup_stats stats;
+				if (not Shared::read_cgroup_stats(dir, stats)) return;
+				string path = (dir == root ? "/" : '/' + dir.lexically_relative(root).string());
+				if (not filter.empty() and not s_contains_ic(path, filter)) return;
+
+				cgroup_info info{.path = path, .mem = stats.mem_current, .nr_throttled = stats.nr_throttled};
+				if (auto prev = cgroup_history.find(path); prev != cgroup_history.end() and now > prev->second.read_us) {
+					const auto& last = prev->second;
+					const double elapsed = now - last.read_us;
+					info.cpu_p = clamp((stats.usage_usec - min(stats.usage_usec, last.usage_usec)) * 100.0 / (elapsed * cores), 0.0, 100.0 * Shared::coreCount / cores);
+					info.throttled_p = clamp((stats.throttled_usec - min(stats.throttled_usec, last.throttled_usec)) * 100.0 / elapsed, 0.0, 100.0);
+					if (stats.has_io and last.has_io) {
+						info.io_read_rate = round((stats.io_read - min(stats.io_read, last.io_read)) * 1'000'000 / elapsed);
+						info.io_write_rate = round((stats.io_write - min(stats.io_write, last.io_write)) * 1'000'000 / elapsed);
+					}
+				}
+				history[path] = {stats.usage_usec, stats.throttled_usec, stats.io_read, stats.io_write, now, stats.has_io};
+				cgroups.push_back(std::move(info));
+			};
+
+			add(root);
+			std::error_code ec;
+			for (fs::recursive_directory_iterator it(root, fs::directory_options::skip_permission_denied, ec), end; not ec and it != end; it.increment(ec)) {
+				if (Runner::stopping) return;
+				if (it->is_directory(ec)) add(it->path());
+			}
+			cgroup_history.swap(history);
+		}
+
+		//? Sorted by memory, by path for the name columns and by time throttled for "top waiters", the cgroup equivalent of run queue wait
+		//? Keys without a cgroup column (threads and page faults) fall back to cpu like "cpu direct" and "cpu lazy"
+		const auto& sorting = Config::getS("proc_sorting");
+		if (sorting == "memory")
+			rng::stable_sort(cgroups, rng::greater{}, &cgroup_info::mem);
+		else if (is_in(sorting, "pid", "name", "command", "user"))
+			rng::stable_sort(cgroups, rng::less{}, &cgroup_info::path);
+		else if (sorting == "top waiters")
+			rng::stable_sort(cgroups, rng::greater{}, &cgroup_info::throttled_p);
+		else
+			rng::stable_sort(cgroups, rng::greater{}, &cgroup_info::cpu_p);
+		if (Config::getB("proc_reversed")) rng::reverse(cgroups);
+	}
+
+	//? Tree view children of each pid in sibling order, kept between updates
+	//? New and reparented processes are appended to the list of their parent, pids that exited or
+	//? moved to another parent are dropped from a list the next time it is visited
+	static std::unordered_map<size_t, vector<size_t>> tree_children;
+	static uint64_t tree_stamp{};
+
+	struct tree_node {
+		proc_info* proc;
+		size_t slot{};  // row of the process in current_procs and hot
+		size_t first{};
+		size_t count{};
+	};
+	static vector<tree_node> tree_nodes;
+	static vector<proc_info*> tree_order;
+	static vector<proc_info*> tree_hidden;
+	static vector<proc_info> tree_scratch;
+
+	//? Sort keys of current_procs, filled before sorting the list or generating the tree so both passes only compare those
+	static hot_columns hot;
+
+	//? Options for a tree generation pass
+	struct tree_context {
+		const string& filter;
+		size_t sort_key;
+		bool reverse;
+		bool sort_siblings;
+		bool no_update;
+		bool should_filter;
+		bool aggregate;
+	};
+
+	//* Link new and reparented processes under their parent, returns the parent pid of the root processes
+	static size_t tree_link(const bool normalize_ppid) {
+		size_t root_ppid = SIZE_MAX;
+		for (auto& p : current_procs) {
+			if (normalize_ppid and not pid_index.contains(p.ppid)) p.ppid = 0;
+			if (not p.tree_linked or p.tree_ppid != p.ppid) {
+				tree_children[p.ppid].push_back(p.pid);
+				p.tree_ppid = p.ppid;
+				p.tree_linked = true;
+			}
+			root_ppid = min(root_ppid, p.ppid);
+		}
+		return root_ppid;
+	}
+
+	//* Append the live children of <ppid> to tree_nodes and compact its list, returns pointer to the list or nullptr
+	static auto tree_resolve(const size_t ppid) -> vector<size_t>* {
+		auto list = tree_children.find(ppid);
+		if (list == tree_children.end()) return nullptr;
+		auto& pids = list->second;
+		size_t kept = 0;
+		for (const auto pid : pids) {
+			auto child = find_proc(pid);
+			if (child == nullptr or child->tree_ppid != ppid or child->tree_stamp == tree_stamp) continue;
+			child->tree_stamp = tree_stamp;
+			tree_nodes.push_back({child, static_cast<size_t>(child - current_procs.data())});
+			pids[kept++] = pid;
+		}
+		pids.resize(kept);
+		return &pids;
+	}
+
+	//* Stable sort <nodes> by the selected sort key the same way as proc_sorter(), returns false if already in order
+	static bool tree_sort_siblings(std::span<tree_node> nodes, const size_t sort_key, const bool reverse) {
+		auto sort_with = [&](auto cmp) {
+			if (rng::is_sorted(nodes, cmp)) return false;
+			rng::stable_sort(nodes, cmp);
+			return true;
+		};
+		auto sort_by = [&](auto member, const bool ascending) {
+			return sort_with([&](const tree_node& a, const tree_node& b) {
+				return ascending ? (*a.proc).*member < (*b.proc).*member : (*b.proc).*member < (*a.proc).*member;
+			});
+		};
+		switch (sort_key) {
+		case 1: return sort_by(&proc_info::name, not reverse);
+		case 2: return sort_by(&proc_info::cmd, not reverse);
+		case 4: return sort_by(&proc_info::user, not reverse);
+		}
+		//? Numbers are compared by their key in the hot columns
+		if (sort_key >= sort_vector.size() or hot.sort_key != sort_key) return false;
+		return sort_with([&](const tree_node& a, const tree_node& b) {
+			return reverse ? hot.key[a.slot] < hot.key[b.slot] : hot.key[b.slot] < hot.key[a.slot];
+		});
+	}
+
+	//* Sort the children of <ppid> in tree_nodes[first, first + count) and store the new order in <pids>
+	static void tree_sort_children(vector<size_t>* pids, const size_t first, const size_t count, const tree_context& ctx) {
+		if (count < 2 or not ctx.sort_siblings
+		or not tree_sort_siblings(std::span(tree_nodes).subspan(first, count), ctx.sort_key, ctx.reverse)) return;
+		for (size_t i = 0; i < count; i++) (*pids)[i] = tree_nodes[first + i].proc->pid;
+	}
+
+	//* Filter, aggregate and sort the subtree of tree_nodes[<node>], same rules as _tree_gen() and tree_sort()
+	static void tree_build(const size_t node, int cur_depth, const bool collapsed, bool found, const tree_context& ctx) {
+		auto& cur_proc = *tree_nodes[node].proc;
+		bool filtering = false;
+
+		//? If filtering, include children of matching processes
+		if (not found and (ctx.should_filter or not ctx.filter.empty())) {
+			if (not matches_filter(cur_proc, ctx.filter)) {
+				filtering = true;
+				cur_proc.filtered = true;
+				filter_found++;
+			}
+			else {
+				found = true;
+				cur_depth = 0;
+			}
+		}
+		else if (cur_proc.filtered) cur_proc.filtered = false;
+
+		cur_proc.depth = cur_depth;
+
+		//? Try to find name of the binary file and append to program name if not the same
+		if (not collapsed and not filtering and cur_proc.short_cmd.empty() and not cur_proc.cmd.empty()) {
+			std::string_view cmd_view = cur_proc.cmd;
+			cmd_view = cmd_view.substr((size_t)0, std::min(cmd_view.find(' '), cmd_view.size()));
+			cmd_view = cmd_view.substr(std::min(cmd_view.find_last_of('/') + 1, cmd_view.size()));
+			cur_proc.short_cmd = string{cmd_view};
+		}
+
+		const size_t slot = tree_nodes[node].slot;
+		const size_t first = tree_nodes.size();
+		auto pids = tree_resolve(cur_proc.pid);
+		const size_t count = tree_nodes.size() - first;
+		tree_nodes[node].first = first;
+		tree_nodes[node].count = count;
+
+		bool summed = false;
+		for (size_t i = first; i < first + count; i++) {
+			auto& p = *tree_nodes[i].proc;
+			if (collapsed and not filtering) {
+				cur_proc.filtered = true;
+			}
+
+			tree_build(i, cur_depth + 1, (collapsed or cur_proc.collapsed), found, ctx);
+
+			if (not ctx.no_update and not filtering and (collapsed or cur_proc.collapsed)) {
+				if (p.state != 'X') {
+					cur_proc.cpu_p += p.cpu_p;
+					cur_proc.cpu_c += p.cpu_c;
+					cur_proc.mem += p.mem;
+					cur_proc.threads += p.threads;
+					cur_proc.minflt_rate += p.minflt_rate;
+					cur_proc.majflt_rate += p.majflt_rate;
+					summed = true;
 				}
+				filter_found++;
+				p.filtered = true;
+			}
+			else if (ctx.aggregate and p.state != 'X') {
+				cur_proc.cpu_p += p.cpu_p;
+				cur_proc.cpu_c += p.cpu_c;
+				cur_proc.mem += p.mem;
+				cur_proc.threads += p.threads;
+				cur_proc.minflt_rate += p.minflt_rate;
+				cur_proc.majflt_rate += p.majflt_rate;
+				summed = true;
 			}
-			catch (const std::invalid_argument&) {}
-			catch (const std::out_of_range&) {}
-			d_read.close();
+		}
+		//? The summed values are sorted among the siblings of the process
+		if (summed) hot.set(slot, cur_proc);
+
+		tree_sort_children(pids, first, count, ctx);
+	}
+
+	//* Set tree index and prefix for tree_nodes[first, first + count) and their children in display order
+	//* Processes below a collapsed parent are already marked as filtered by tree_build()
+	static void tree_place(const size_t first, const size_t count, const uint64_t lines, const size_t level, int& c_index, const int index_max) {
+		for (size_t i = first; i < first + count; i++) {
+			const auto& node = tree_nodes[i];
+			auto& p = *node.proc;
+			const bool is_last = (i == first + count - 1);
+			p.tree_index = (p.filtered ? index_max : c_index++);
+			if (p.filtered) p.depth = 0;
+			p.prefix_lines = lines;
+			p.prefix_last = is_last;
+			p.prefix_parent = node.count > 0;
+			(p.filtered ? tree_hidden : tree_order).push_back(&p);
+
+			tree_place(node.first, node.count, (p.filtered ? 0 : lines | (is_last or level >= 64 ? 0 : 1ull << level)),
+				(p.filtered ? 0 : level + 1), c_index, index_max);
 		}
 	}
 
+	//* Reorder current_procs into tree view order from the persistent parent to children lists
+	//* Only births and reparented processes touch the lists and only siblings out of order are sorted
+	static void tree_gen(const tree_context& ctx, const bool normalize_ppid) {
+		const size_t root_ppid = tree_link(normalize_ppid);
+		++tree_stamp;
+
+		tree_nodes.clear();
+		tree_nodes.reserve(current_procs.size());
+		auto roots = tree_resolve(root_ppid);
+		const size_t root_count = tree_nodes.size();
+		for (size_t i = 0; i < root_count; i++) {
+			tree_build(i, 0, false, false, ctx);
+		}
+		tree_sort_children(roots, 0, root_count, ctx);
+
+		//? Drop lists of parents that are no longer in the tree, their children are linked again if the parent comes back
+		std::erase_if(tree_children, [&](const auto& entry) {
+			auto parent = find_proc(entry.first);
+			if (entry.first == root_ppid or (parent != nullptr and parent->tree_stamp == tree_stamp)) return false;
+			for (const auto pid : entry.second) {
+				if (auto child = find_proc(pid); child != nullptr and child->tree_ppid == entry.first) child->tree_linked = false;
+			}
+			return true;
+		});
+
+		//? Visible processes first in tree order, followed by collapsed, filtered and unreachable processes
+		tree_order.clear();
+		tree_hidden.clear();
+		int c_index = 0;
+		const int index_max = current_procs.size();
+		tree_place(0, root_count, 0, 0, c_index, index_max);
+		for (auto& p : current_procs) {
+			if (p.tree_stamp != tree_stamp) {
+				p.tree_index = index_max;
+				tree_hidden.push_back(&p);
+			}
+		}
+
+		tree_scratch.clear();
+		tree_scratch.reserve(current_procs.size());
+		for (auto* p : tree_order) tree_scratch.push_back(std::move(*p));
+		for (auto* p : tree_hidden) tree_scratch.push_back(std::move(*p));
+		current_procs.swap(tree_scratch);
+	}
+
 	//* Collects and sorts process information from /proc
 	auto collect(bool no_update) -> vector<proc_info>& {
 		if (Runner::stopping) return current_procs;
+		//? The cgroup view only reads the cgroups, processes are read again once a cgroup is selected
+		if (Config::getB("proc_cgroup_view")) {
+			_collect_cgroups(no_update);
+			numpids = cgroups.size();
+			return current_procs;
+		}
+		else if (not cgroups.empty()) {
+			cgroups.clear();
+			cgroup_history.clear();
+		}
 		const auto& sorting = Config::getS("proc_sorting");
 		auto reverse = Config::getB("proc_reversed");
 		const auto& filter = Config::getS("proc_filter");
 		auto per_core = Config::getB("proc_per_core");
 		auto should_filter_kernel = Config::getB("proc_filter_kernel");
-		auto tree = Config::getB("proc_tree");
+		auto tree = Config::getB("proc_tree") and not Config::getB("proc_group_programs");
 		auto show_detailed = Config::getB("show_detailed");
 		const auto pause_proc_list = Config::getB("pause_proc_list");
 		const size_t detailed_pid = Config::getI("detailed_pid");
@@ -2924,268 +4156,202 @@ namespace Proc {
 			current_rev = reverse;
 		}
 		if (tree_mode_change) is_tree_mode = tree;
-		ifstream pread;
-		string long_string;
-		string short_str;
-
-		static vector<size_t> found;
 
-		const double uptime = system_uptime();
+		const double uptime = Shared::tick.uptime;
 
 		const int cmult = (per_core) ? Shared::coreCount : 1;
 		bool got_detailed = false;
 
-		static size_t proc_clear_count{};
-
 		//* Use pids from last update if only changing filter, sorting or tree options
 		if (no_update and not current_procs.empty()) {
-			if (show_detailed and detailed_pid != detailed.last_pid) _collect_details(detailed_pid, round(uptime), current_procs);
+			if (show_detailed and detailed_pid != detailed.last_pid) _collect_details(detailed_pid, round(uptime));
 		}
 		//* ---------------------------------------------Collection start----------------------------------------------
 		else {
 			should_filter = true;
-			found.clear();
+			++collect_gen;
 
-			//? First make sure kernel proc cache is cleared.
-			if (should_filter_kernel and ++proc_clear_count >= 256) {
-				//? Clearing the cache is used in the event of a pid wrap around.
-				//? In that event processes that acquire old kernel pids would also be filtered out so we need to manually clean the cache every now and then.
-				kernels_procs.clear();
-				kernels_procs.emplace(KTHREADD);
-				proc_clear_count = 0;
-			}
+			if (not should_filter_kernel) kernel_threads.clear();
 
 			auto totalMem = Mem::get_totalMem();
-			int totalMem_len = to_string(totalMem >> 10).size();
 
 			//? Update uid_user map if /etc/passwd changed since last run
 			if (not Shared::passwd_path.empty() and fs::last_write_time(Shared::passwd_path) != passwd_time) {
-				string r_uid, r_user;
 				passwd_time = fs::last_write_time(Shared::passwd_path);
 				uid_user.clear();
-				pread.open(Shared::passwd_path);
-				if (pread.good()) {
-					while (pread.good()) {
-						getline(pread, r_user, ':');
-						pread.ignore(SSmax, ':');
-						getline(pread, r_uid, ':');
-						if (uid_user.contains(r_uid)) break;
-						uid_user[r_uid] = r_user;
-						pread.ignore(SSmax, '\n');
-					}
-				}
-				else {
+				if (auto buf = read_at(AT_FDCWD, Shared::passwd_path.c_str()); buf.has_value())
+					_parse_passwd(*buf);
+				else
 					Shared::passwd_path.clear();
-				}
-				pread.close();
 			}
+			_apply_user_lookups();
 
-			//? Get cpu total times from /proc/stat
+			//? Get cpu total times from the same /proc/stat snapshot as the cpu box, so both show the same usage
 			cputimes = 0;
-			pread.open(Shared::procPath / "stat");
-			if (pread.good()) {
-				pread.ignore(SSmax, ' ');
-				for (uint64_t times; pread >> times; cputimes += times);
+			if (not Shared::tick.stat.empty()) {
+				FieldScanner stat(FieldScanner(Shared::tick.stat).line());
+				stat.skip();
+				for (uint64_t times; stat.next(times); cputimes += times);
 			}
 			else throw std::runtime_error("Failure to read /proc/stat");
-			pread.close();
-
-			//? Iterate over all pids in /proc
-			for (const auto& d: fs::directory_iterator(Shared::procPath)) {
-				if (Runner::stopping)
-					return current_procs;
-
-				if (pread.is_open()) pread.close();
 
-				const string pid_str = d.path().filename();
-				if (not isdigit(pid_str[0])) continue;
+			//? Start or stop listening for process events if the option changed, events are not used when restricted to a cgroup
+			const auto& cgroup = Shared::selected_cgroup();
+			static bool proc_events_failed{};
+			if (not Config::getB("proc_events") or not cgroup.empty()) {
+				proc_events.stop();
+				proc_events_failed = false;
+			}
+			else if (not proc_events.running() and not proc_events_failed)
+				proc_events_failed = not proc_events.start();
 
-				const size_t pid = stoul(pid_str);
+			//? Get live pids from the selected cgroup and the cgroups below it, from process events, or iterate over all pids in /proc
+			const bool from_events = proc_events.take(proc_pids, fork_pids, exec_pids, exited_procs);
 
-				if (should_filter_kernel and kernels_procs.contains(pid)) {
-					continue;
+			//? A kernel thread pid reported as exited or forked since the last update belongs to a new process if listed again
+			if (should_filter_kernel) {
+				for (const auto pid : fork_pids) kernel_threads.erase(pid);
+				for (const auto& exited : exited_procs) kernel_threads.erase(exited.pid);
+			}
+			if (from_events) {
+				rng::sort(proc_pids);
+			}
+			else if (not cgroup.empty()) {
+				proc_pids.clear();
+				Shared::read_cgroup_pids(cgroup, proc_pids);
+			}
+			else {
+				proc_pids.clear();
+				std::unique_ptr<DIR, DirCloser> proc_dir(opendir(Shared::procPath.c_str()));
+				if (proc_dir == nullptr) throw std::runtime_error("Failure to read /proc");
+				while (const auto* d = readdir(proc_dir.get())) {
+					if (Runner::stopping)
+						return current_procs;
+
+					if (not isdigit(d->d_name[0])) continue;
+
+					size_t pid{};
+					std::from_chars(d->d_name, d->d_name + strlen(d->d_name), pid);
+					proc_pids.push_back(pid);
 				}
+				if (proc_events.running()) proc_events.merge(proc_pids);
+			}
 
-				found.push_back(pid);
+			proc_jobs.clear();
+			const auto idle_refresh = static_cast<size_t>(Config::getI("proc_idle_refresh"));
+			const auto cmd_refresh = static_cast<size_t>(Config::getI("proc_cmd_refresh"));
+			for (const auto pid : proc_pids) {
+				//? Known kernel threads are skipped without reading cmdline and status, stat is read every update to tell a reused pid apart by its start time
+				if (should_filter_kernel) {
+					if (auto kthread = kernel_threads.find(pid); kthread != kernel_threads.end()) {
+						kthread->second.seen_gen = collect_gen;
+						auto buf = read_at(Shared::procDir.get(), pid_file(pid, "stat"), 0, true);
+						if (pid_stat stat; buf.has_value() and parse_pid_stat(*buf, stat) and stat.starttime == kthread->second.starttime) continue;
+						kernel_threads.erase(kthread);
+					}
+				}
 
 				//? Check if pid already exists in current_procs
-				auto find_old = rng::find(current_procs, pid, &proc_info::pid);
+				auto find_old = find_proc(pid);
 				bool no_cache{};
 				//? Only add new processes if not paused
-				if (find_old == current_procs.end()) {
+				if (find_old == nullptr) {
 					if (not pause_proc_list) {
-						current_procs.push_back({pid});
-						find_old = current_procs.end() - 1;
+						pid_index.emplace(pid, current_procs.size());
+						find_old = &current_procs.emplace_back(proc_info{pid});
 						no_cache = true;
 					}
 					else continue;
 				}
-				else if (dead_procs.contains(pid)) continue;
-
-				auto& new_proc = *find_old;
-
-				//? Get program name, command and username
-				if (no_cache) {
-					pread.open(d.path() / "comm");
-					if (not pread.good()) continue;
-					getline(pread, new_proc.name);
-					pread.close();
-					//? Check for whitespace characters in name and set offset to get correct fields from stat file
-					new_proc.name_offset = rng::count(new_proc.name, ' ');
-
-					pread.open(d.path() / "cmdline");
-					if (not pread.good()) continue;
-					long_string.clear();
-					while(getline(pread, long_string, '\0')) {
-						new_proc.cmd += long_string + ' ';
-						if (new_proc.cmd.size() > 1000) {
-							new_proc.cmd.resize(1000);
-							break;
-						}
-					}
-					pread.close();
-					if (not new_proc.cmd.empty()) new_proc.cmd.pop_back();
-
-					pread.open(d.path() / "status");
-					if (not pread.good()) continue;
-					string uid;
-					string line;
-					while (pread.good()) {
-						getline(pread, line, ':');
-						if (line == "Uid") {
-							pread.ignore();
-							getline(pread, uid, '\t');
-							break;
-						} else {
-							pread.ignore(SSmax, '\n');
-						}
-					}
-					pread.close();
-					if (uid_user.contains(uid)) {
-						new_proc.user = uid_user.at(uid);
-					}
-					else {
-					#if !(defined(STATIC_BUILD) && defined(__GLIBC__))
-						try {
-							struct passwd* udet;
-							udet = getpwuid(stoi(uid));
-							if (udet != nullptr and udet->pw_name != nullptr) {
-								new_proc.user = string(udet->pw_name);
-							}
-							else {
-								new_proc.user = uid;
-							}
-						}
-						catch (...) { new_proc.user = uid; }
-					#else
-						new_proc.user = uid;
-					#endif
-					}
+				//? Name and command line changes after exec()
+				else if (exec_pids.contains(pid)) {
+					find_old->short_cmd.clear();
+					no_cache = true;
 				}
-
-				//? Parse /proc/[pid]/stat
-				pread.open(d.path() / "stat");
-				if (not pread.good()) continue;
-
-				const auto& offset = new_proc.name_offset;
-				short_str.clear();
-				int x = 0, next_x = 3;
-				uint64_t cpu_t = 0;
-				try {
-					for (;;) {
-						while (pread.good() and ++x < next_x + offset) pread.ignore(SSmax, ' ');
-						if (not pread.good()) break;
-						else getline(pread, short_str, ' ');
-
-						switch (x-offset) {
-							case 3: //? Process state
-								new_proc.state = short_str.at(0);
-								if (new_proc.ppid != 0) next_x = 14;
-								continue;
-							case 4: //? Parent pid
-								new_proc.ppid = stoull(short_str);
-								next_x = 14;
-								continue;
-							case 14: //? Process utime
-								cpu_t = stoull(short_str);
-								continue;
-							case 15: //? Process stime
-								cpu_t += stoull(short_str);
-								next_x = 19;
-								continue;
-							case 19: //? Nice value
-								new_proc.p_nice = stoll(short_str);
-								continue;
-							case 20: //? Number of threads
-								new_proc.threads = stoull(short_str);
-								if (new_proc.cpu_s == 0) {
-									next_x = 22;
-									new_proc.cpu_t = cpu_t;
-								}
-								else
-									next_x = 24;
-								continue;
-							case 22: //? Get cpu seconds if missing
-								new_proc.cpu_s = stoull(short_str);
-								next_x = 24;
-								continue;
-							case 24: //? RSS memory (can be inaccurate, but parsing smaps increases total cpu usage by ~20x)
-								if (cmp_greater(short_str.size(), totalMem_len))
-									new_proc.mem = totalMem;
-								else
-									new_proc.mem = stoull(short_str) * Shared::pageSize;
-						}
-						break;
-					}
-
+				//? Re-read name, command and user of long running processes every <cmd_refresh> updates, spread over pids
+				else if (cmd_refresh > 0 and (pid + collect_gen) % cmd_refresh == 0) {
+					find_old->short_cmd.clear();
+					no_cache = true;
 				}
-				catch (const std::invalid_argument&) { continue; }
-				catch (const std::out_of_range&) { continue; }
+				find_old->seen_gen = collect_gen;
+				if (not no_cache and dead_procs.contains(pid)) continue;
 
-				pread.close();
+				//? Processes that used no cpu time and caused no page faults when last read are only read every <idle_refresh> updates, spread over pids
+				if (idle_refresh > 1 and not no_cache and find_old->cpu_p == 0.0 and find_old->state != 'R'
+				and find_old->minflt_rate == 0.0 and find_old->majflt_rate == 0.0
+				and pid != detailed_pid and (pid + collect_gen) % idle_refresh != 0) continue;
 
-				if (should_filter_kernel and new_proc.ppid == KTHREADD) {
-					kernels_procs.emplace(new_proc.pid);
-					found.pop_back();
-				}
+				auto& job = proc_jobs.emplace_back();
+				job.slot = find_old - current_procs.data();
+				job.no_cache = no_cache;
+			}
+			//? Kernel threads that weren't listed have exited
+			std::erase_if(kernel_threads, [](const auto& kthread) { return kthread.second.seen_gen != collect_gen; });
+
+			//? Parse the claimed processes in contiguous shards, each worker only writes to its own jobs and slots
+			proc_workers.resize(Config::getI("proc_collect_threads"));
+			const parse_context ctx{totalMem, uptime, cmult, should_filter_kernel, sorting == "top waiters", Shared::tick.time_us};
+			const size_t shards = proc_workers.shards();
+			proc_workers.run([&](size_t shard) {
+				const size_t first = proc_jobs.size() * shard / shards;
+				const size_t last = proc_jobs.size() * (shard + 1) / shards;
+				for (size_t i = first; i < last and not Runner::stopping; i++)
+					_parse_proc(proc_jobs[i], ctx);
+			});
+			if (Runner::stopping) return current_procs;
 
-				if (x-offset < 24) continue;
+			//? Merge results that need shared state, done on this thread in pid order
+			for (const auto& job : proc_jobs) {
+				auto& new_proc = current_procs[job.slot];
+				if (job.got_uid) new_proc.user = _get_user(job.uid);
 
-				//? Get RSS memory from /proc/[pid]/statm if value from /proc/[pid]/stat looks wrong
-				if (new_proc.mem >= totalMem) {
-					pread.open(d.path() / "statm");
-					if (not pread.good()) continue;
-					pread.ignore(SSmax, ' ');
-					pread >> new_proc.mem;
-					new_proc.mem *= Shared::pageSize;
-					pread.close();
+				if (job.kernel) {
+					kernel_threads.insert_or_assign(new_proc.pid, kernel_thread{new_proc.cpu_s, collect_gen});
+					new_proc.seen_gen = 0;
 				}
 
-				//? Process cpu usage since last update
-				new_proc.cpu_p = clamp(round(cmult * 1000 * (cpu_t - new_proc.cpu_t) / max((uint64_t)1, cputimes - old_cputimes)) / 10.0, 0.0, 100.0 * Shared::coreCount);
-
-				//? Process cumulative cpu usage since process start
-				new_proc.cpu_c = (double)cpu_t / max(1.0, (uptime * Shared::clkTck) - new_proc.cpu_s);
+				if (show_detailed and not got_detailed and job.parsed and new_proc.pid == detailed_pid) {
+					got_detailed = true;
+				}
 
-				//? Update cached value with latest cpu times
-				new_proc.cpu_t = cpu_t;
+				//? Pids that exited without the event being seen are dropped from the live set once they can't be read
+				if (from_events and not job.parsed) proc_events.forget(new_proc.pid);
+			}
 
-				if (show_detailed and not got_detailed and new_proc.pid == detailed_pid) {
-					got_detailed = true;
+			//? Add processes that started and exited since last update, these are only known through process events
+			if (not pause_proc_list) {
+				for (auto& exited : exited_procs) {
+					if ((not exited.got_stat and exited.name.empty()) or find_proc(exited.pid) != nullptr
+					or (should_filter_kernel and exited.kernel)) continue;
+					pid_index.emplace(exited.pid, current_procs.size());
+					auto& dead_proc = current_procs.emplace_back(proc_info{exited.pid});
+					dead_proc.name = std::move(exited.name);
+					dead_proc.cmd = std::move(exited.cmd);
+					if (exited.uid.has_value()) dead_proc.user = _get_user(*exited.uid);
+					dead_proc.state = 'X';
+					dead_proc.ppid = exited.ppid;
+					dead_proc.threads = 1;
+					dead_proc.cpu_t = exited.cpu_t;
+					dead_proc.cpu_s = exited.cpu_s;
+					dead_proc.cpu_p = clamp(round(cmult * 1000 * exited.cpu_t / max((uint64_t)1, cputimes - old_cputimes)) / 10.0, 0.0, 100.0 * Shared::coreCount);
+					dead_proc.cpu_c = (double)exited.cpu_t / max(1.0, (uptime * Shared::clkTck) - exited.cpu_s);
+					dead_proc.death_time = round(uptime) - (exited.cpu_s / Shared::clkTck);
+					dead_proc.seen_gen = collect_gen;
 				}
 			}
 
 			//? Clear dead processes from current_procs and remove kernel processes if enabled and not paused
 			if (not pause_proc_list) {
-				auto eraser = rng::remove_if(current_procs, [&](const auto& element){ return not v_contains(found, element.pid); });
+				auto eraser = rng::remove_if(current_procs, [&](const auto& element){ return element.seen_gen != collect_gen; });
 				current_procs.erase(eraser.begin(), eraser.end());
 				if (!dead_procs.empty()) dead_procs.clear();
+				reindex();
 			}
 			//? Set correct state of dead processes if paused
 			else {
 				const bool keep_dead_proc_usage = Config::getB("keep_dead_proc_usage");
 				for (auto& r : current_procs) {
-					if (rng::find(found, r.pid) == found.end()) {
+					if (r.seen_gen != collect_gen) {
 						if (r.state != 'X') r.death_time = round(uptime) - (r.cpu_s / Shared::clkTck);
 						r.state = 'X';
 						dead_procs.emplace(r.pid);
@@ -3200,7 +4366,7 @@ namespace Proc {
 
 			//? Update the details info box for process if active
 			if (show_detailed and got_detailed) {
-				_collect_details(detailed_pid, round(uptime), current_procs);
+				_collect_details(detailed_pid, round(uptime));
 			}
 			else if (show_detailed and not got_detailed and detailed.status != "Dead") {
 				detailed.status = "Dead";
@@ -3228,25 +4394,31 @@ namespace Proc {
 			}
 		}
 
-		//* Sort processes
-		if ((sorted_change or tree_mode_change) or (not no_update and not pause_proc_list)) {
-			proc_sorter(current_procs, sorting, reverse, tree);
+		//* Sort processes, in tree mode siblings are sorted while generating the tree
+		const bool resort = (sorted_change or tree_mode_change) or (not no_update and not pause_proc_list);
+		if (not tree) {
+			//? Only the rows up to the bottom of the current view are ordered, unless a filter or followed process needs the whole list
+			static size_t sorted_rows{};
+			const size_t rows = (filter.empty() and Proc::select_max > 0 and not Config::getB("follow_process") and Config::getI("restore_detailed_pid") == 0)
+				? Config::getI("proc_start") + Proc::select_max + columns_margin : 0;
+
+			//? Extend the ordered rows when scrolling past them
+			if (resort or (sorted_rows != 0 and (rows == 0 or rows > sorted_rows))) {
+				hot.fill(current_procs, v_index(sort_vector, sorting));
+				proc_sorter(current_procs, sorting, reverse, tree, rows, &hot);
+				sorted_rows = rows;
+			}
 		}
 
 		//* Generate tree view if enabled
-		if (tree and (not no_update or should_filter or sorted_change)) {
+		if (tree and (not no_update or should_filter or sorted_change or tree_mode_change)) {
 			bool locate_selection = false;
 
 			if (toggle_children != -1) {
 				auto collapser = rng::find(current_procs, toggle_children, &proc_info::pid);
 				if (collapser != current_procs.end()){
 					for (auto& p : current_procs) {
-						if (p.ppid == collapser->pid) {
-							auto child = rng::find(current_procs, p.pid, &proc_info::pid);
-							if (child != current_procs.end()){
-								child->collapsed = not child->collapsed;
-							}
-						}
+						if (p.ppid == collapser->pid) p.collapsed = not p.collapsed;
 					}
 					if (Config::ints.at("proc_selected") > 0) locate_selection = true;
 				}
@@ -3271,34 +4443,13 @@ namespace Proc {
 			}
 			if (should_filter or not filter.empty()) filter_found = 0;
 
-			vector<tree_proc> tree_procs;
-			tree_procs.reserve(current_procs.size());
-
-			if (!pause_proc_list) {
-				for (auto& p : current_procs) {
-					if (not v_contains(found, p.ppid)) p.ppid = 0;
-				}
-			}
-
-			//? Stable sort to retain selected sorting among processes with the same parent
-			rng::stable_sort(current_procs, rng::less{}, & proc_info::ppid);
-
-			//? Start recursive iteration over processes with the lowest shared parent pids
-			for (auto& p : rng::equal_range(current_procs, current_procs.at(0).ppid, rng::less{}, &proc_info::ppid)) {
-				_tree_gen(p, current_procs, tree_procs, 0, false, filter, false, no_update, should_filter);
-			}
-
-			//? Recursive sort over tree structure to account for collapsed processes in the tree
-			int index = 0;
-			tree_sort(tree_procs, sorting, reverse, (pause_proc_list and not (sorted_change or tree_mode_change)), index, current_procs.size());
-
-			//? Recursive construction of ASCII tree prefixes.
-			for (auto t = tree_procs.begin(); t != tree_procs.end(); ++t) {
-				_collect_prefixes(*t, t == tree_procs.end() - 1);
-			}
-
-			//? Final sort based on tree index
-			rng::stable_sort(current_procs, rng::less {}, &proc_info::tree_index);
+			//? Siblings are only sorted if the list was resorted, aggregated values are sorted again unless paused
+			const auto sort_key = v_index(sort_vector, sorting);
+			const bool tree_paused = pause_proc_list and not (sorted_change or tree_mode_change);
+			const tree_context ctx{filter, sort_key, reverse, (resort or (not tree_paused and sort_key >= 3 and sort_key != 4)),
+				no_update, should_filter, Config::getB("proc_aggregate")};
+			hot.fill(current_procs, sort_key);
+			tree_gen(ctx, not pause_proc_list);
 
 			//? Move current selection/view to the selected process when collapsing/expanding in the tree
 			if (locate_selection) {
@@ -3309,6 +4460,12 @@ namespace Proc {
 			}
 		}
 
+		//? Slots has moved if processes were sorted or the tree was regenerated
+		reindex();
+
+		//? The wait column is always read for visible rows when sorting by it
+		_collect_columns(Config::getS("proc_columns") + (sorting == "top waiters" ? " wait" : ""), tree, no_update);
+
 		numpids = (int)current_procs.size() - filter_found;
 
 		return current_procs;
@@ -3317,16 +4474,9 @@ namespace Proc {
 
 namespace Tools {
 	double system_uptime() {
-		string upstr;
-		ifstream pread(Shared::procPath / "uptime");
-		if (pread.good()) {
-			try {
-				getline(pread, upstr, ' ');
-				pread.close();
-				return stod(upstr);
-			}
-			catch (const std::invalid_argument&) {}
-			catch (const std::out_of_range&) {}
+		if (auto buf = read_at(Shared::procDir.get(), "uptime", 0, true); buf.has_value()) {
+			double uptime{};
+			if (FieldScanner(*buf).next(uptime)) return uptime;
 		}
         throw std::runtime_error(fmt::format("Failed to get uptime from {}", Shared::procPath / "uptime"));
 	}
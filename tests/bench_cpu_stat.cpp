@@ -0,0 +1,118 @@
+// SPDX-License-Identifier: Apache-2.0
+
+//* Microbenchmark of reading and parsing /proc/stat as done by Cpu::collect(), comparing Cpu::parse_cpu_stat_line() with the earlier parsers
+//* The file has the layout of /proc/stat on a 512 thread machine, with the intr, ctxt and softirq lines that follow the cpu lines
+//* Usage: btop_bench_cpu_stat [cores] [updates]
+
+#include <charconv>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <fmt/format.h>
+
+#include "btop_shared.hpp"
+#include "btop_tools.hpp"
+
+namespace fs = std::filesystem;
+
+namespace {
+	auto make_stat(size_t cores) -> std::string {
+		auto line = [](std::string_view name, uint64_t seed) {
+			return fmt::format("{} {} {} {} {} {} 0 {} 0 0 0\n", name, 1200000 + seed * 37, 3100 + seed % 97, 410000 + seed * 11,
+				98000000 + seed * 1301, 52000 + seed % 4099, 1800 + seed % 211, 9000 + seed % 1201);
+		};
+		std::string stat = line("cpu", cores * 1000);
+		for (size_t core = 0; core < cores; core++) stat += line(fmt::format("cpu{}", core), core);
+		stat += "intr 2914828411 27 0 0 0 0 0 0 0 1 0 0 0 0 0 0 0 35 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0\n";
+		stat += "ctxt 5638122761\nbtime 1718000000\nprocesses 10837466\nprocs_running 3\nprocs_blocked 0\n";
+		stat += "softirq 1420397262 0 260348441 1204 86032251 2097152 0 5033071 610238911 1183 457845289\n";
+		return stat;
+	}
+
+	//* The iostream based parser used before, reopening the file every update
+	long long parse_iostream(const fs::path& path) {
+		std::ifstream cread(path);
+		std::string cpu_name;
+		long long sum{};
+		for (int i = 0; cread.good() and cread.peek() == 'c'; i++) {
+			if (i == 0) cread.ignore(std::numeric_limits<std::streamsize>::max(), ' ');
+			else {
+				cread >> cpu_name;
+				sum += std::stoi(cpu_name.substr(3));
+			}
+			std::vector<long long> times;
+			for (uint64_t val; cread >> val;) times.push_back(val);
+			cread.clear();
+			if (times.size() >= 4) sum += times[3];
+		}
+		return sum;
+	}
+
+	//* Field scanner over a buffer from read_at() with a vector of fields, the parser used before parse_cpu_stat_line()
+	long long parse_scanner(const fs::path& path) {
+		auto buf = Tools::read_at(AT_FDCWD, path.c_str(), 0, true);
+		if (not buf.has_value()) return 0;
+		Tools::FieldScanner stat(*buf);
+		std::vector<long long> times;
+		long long sum{};
+		while (stat.rest().starts_with('c')) {
+			Tools::FieldScanner line(stat.line());
+			const auto cpu_name = line.next();
+			int core = -1;
+			if (cpu_name.size() > 3) std::from_chars(cpu_name.data() + 3, cpu_name.data() + cpu_name.size(), core);
+			sum += core;
+			times.clear();
+			for (long long val; line.next(val);) times.push_back(val);
+			if (times.size() >= 4) sum += times[3];
+		}
+		return sum;
+	}
+
+	//* Kept open file read with pread() and parsed without allocating
+	long long parse_lines(const Tools::FileFd& file) {
+		auto buf = file.read(0, true);
+		if (not buf.has_value()) return 0;
+		Tools::FieldScanner stat(*buf);
+		Cpu::cpu_stat_line line;
+		long long sum{};
+		while (stat.rest().starts_with("cpu")) {
+			if (Cpu::parse_cpu_stat_line(stat.line(), line)) sum += line.core + line.fields[3];
+		}
+		return sum;
+	}
+
+	template <typename F>
+	void run(const char* name, size_t updates, F&& parse) {
+		uint64_t best = UINT64_MAX;
+		long long check{};
+		for (int round = 0; round < 5; round++) {
+			const auto start = Tools::time_micros();
+			for (size_t i = 0; i < updates; i++) check += parse();
+			best = std::min(best, Tools::time_micros() - start);
+		}
+		fmt::print("{:<20} {:>8.1f} us/update  (checksum {})\n", name, (double)best / updates, check);
+	}
+}
+
+int main(int argc, char** argv) {
+	const size_t cores = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 512;
+	const size_t updates = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 2000;
+
+	const auto path = fs::temp_directory_path() / fmt::format("btop_bench_cpu_stat_{}", getpid());
+	std::ofstream(path) << make_stat(cores);
+	const Tools::FileFd file(AT_FDCWD, path.c_str());
+
+	fmt::print("{} cores, {} updates\n", cores, updates);
+	run("iostream", updates, [&] { return parse_iostream(path); });
+	run("read_at + vector", updates, [&] { return parse_scanner(path); });
+	run("parse_cpu_stat_line", updates, [&] { return parse_lines(file); });
+
+	fs::remove(path);
+}
@@ -0,0 +1,279 @@
+// SPDX-License-Identifier: Apache-2.0
+
+//* Benchmark of Proc::collect() over a synthetic /proc tree
+//* Usage: btop_bench_proc [-t threads]... [-f] [pid count...]
+//* With -f the time to refilter the list for each keystroke of a typed filter is measured instead
+//* With -s only Proc::proc_sorter() is measured, for the whole list and for the first 60 rows, with keys read from the processes and from hot columns
+//* With -S a resort of the collected list followed by a redraw of the process box is measured, like changing the sorting in a running btop
+//* With -d the update of the detailed view is measured for a process with <pid count> memory mappings
+
+#include <cstdlib>
+#include <fcntl.h>
+#include <filesystem>
+#include <random>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "btop_config.hpp"
+#include "btop_draw.hpp"
+#include "btop_shared.hpp"
+#include "btop_theme.hpp"
+#include "btop_tools.hpp"
+
+namespace fs = std::filesystem;
+
+namespace Shared {
+	extern fs::path procPath, passwd_path;
+	extern long pageSize, clkTck;
+	extern Tools::DirFd procDir;
+}
+
+namespace {
+	void write_file(const fs::path& path, const std::string& content) {
+		std::ofstream file(path);
+		file << content;
+	}
+
+	//* Populate <root> with <count> pid directories in a shallow tree and the system wide files read by Proc::collect()
+	void make_fake_proc(const fs::path& root, size_t count) {
+		fs::create_directories(root);
+		write_file(root / "stat", "cpu  10000 200 3000 400000 500 0 60 0 0 0\n");
+		write_file(root / "uptime", "12345.67 98765.43\n");
+		write_file(root / "meminfo", "MemTotal:       65536000 kB\nMemFree:        32768000 kB\n");
+
+		for (size_t pid = 1; pid <= count; pid++) {
+			const auto dir = root / std::to_string(pid);
+			const auto name = fmt::format("worker {}", pid % 12);
+			fs::create_directory(dir);
+			write_file(dir / "comm", name + '\n');
+			write_file(dir / "cmdline", fmt::format("/usr/bin/worker{}{}--id={}{}", pid % 12, '\0', pid, '\0'));
+			write_file(dir / "status", fmt::format("Name:\t{}\nState:\tS (sleeping)\nUid:\t{}\t{}\t{}\t{}\n", name, 1000 + pid % 5, 0, 0, 0));
+			write_file(dir / "stat", fmt::format("{} ({}) S {} {} 0 0 -1 4194304 100 0 0 0 {} {} 0 0 20 0 1 0 {} 1000000 {} 0\n",
+				pid, name, (pid == 1 ? 0 : pid / 8 + 1), pid, pid % 100, pid % 10, pid * 3, 250 + pid % 50));
+			write_file(dir / "statm", "1000 250 100 1 0 200 0\n");
+		}
+	}
+
+	//* Resident set size of the benchmark process
+	auto rss_kib() -> uint64_t {
+		uint64_t rss{};
+		if (auto buf = Tools::read_at(AT_FDCWD, "/proc/self/status"); buf.has_value())
+			if (auto line = Tools::find_key(*buf, "VmRSS"); line.has_value()) Tools::FieldScanner(*line).next(rss);
+		return rss;
+	}
+
+	void run(size_t count, const std::vector<int>& threads) {
+		const auto root = fs::temp_directory_path() / fmt::format("btop_bench_proc_{}", getpid());
+		make_fake_proc(root, count);
+		Shared::procPath = root;
+		Shared::procDir = Tools::DirFd(root);
+		Shared::update_tick();
+
+		for (const int thread_count : threads) {
+			Config::set("proc_collect_threads", thread_count);
+			for (const bool tree : {false, true}) {
+				Config::set("proc_tree", tree);
+				Proc::collect();
+				uint64_t total{}, best = UINT64_MAX;
+				constexpr int ticks = 5;
+				for (int i = 0; i < ticks; i++) {
+					const auto start = Tools::time_micros();
+					Proc::collect();
+					const auto elapsed = Tools::time_micros() - start;
+					total += elapsed;
+					best = std::min(best, elapsed);
+				}
+				fmt::print("{:>8} pids {:>2} threads {:>5}: avg {:>9} us  best {:>9} us  ({:.2f} us/pid)  rss {} KiB\n",
+					count, thread_count, (tree ? "tree" : "flat"), total / ticks, best, (double)best / count, rss_kib());
+			}
+		}
+
+		fs::remove_all(root);
+	}
+
+	//* Type each filter one character at a time and time the update that follows every keystroke
+	void run_filter(size_t count) {
+		const auto root = fs::temp_directory_path() / fmt::format("btop_bench_proc_{}", getpid());
+		make_fake_proc(root, count);
+		Shared::procPath = root;
+		Shared::procDir = Tools::DirFd(root);
+		Shared::update_tick();
+
+		for (const bool tree : {false, true}) {
+			Config::set("proc_tree", tree);
+			for (const std::string filter : {"worker 11", "!worker1[0-9]"}) {
+				Config::set("proc_filter", ""s);
+				Proc::collect();
+				uint64_t total{}, worst{};
+				for (size_t len = 1; len <= filter.size(); len++) {
+					Config::set("proc_filter", filter.substr(0, len));
+					const auto start = Tools::time_micros();
+					Proc::collect(true);
+					const auto elapsed = Tools::time_micros() - start;
+					total += elapsed;
+					worst = std::max(worst, elapsed);
+				}
+				fmt::print("{:>8} pids {:>5} {:<15}: avg {:>9} us  worst {:>9} us per keystroke\n",
+					count, (tree ? "tree" : "flat"), filter, total / filter.size(), worst);
+			}
+		}
+		Config::set("proc_filter", ""s);
+
+		fs::remove_all(root);
+	}
+
+	//* Sort a synthetic list by every column, each run starts from the order left by the previous one like a running btop
+	void run_sort(size_t count) {
+		std::mt19937 rng(count);
+		std::vector<Proc::proc_info> procs;
+		for (size_t pid = 1; pid <= count; pid++) {
+			auto& p = procs.emplace_back(Proc::proc_info{pid});
+			p.name = fmt::format("worker {}", rng() % 500);
+			p.cmd = fmt::format("/usr/bin/{} --id={}", p.name, pid);
+			p.user = fmt::format("user{}", rng() % 20);
+			p.threads = 1 + rng() % 8;
+			p.mem = (rng() % 100000) * 4096;
+			p.cpu_p = (rng() % 10 == 0 ? (rng() % 1000) / 10.0 : 0.0);
+			p.cpu_c = (rng() % 10000) / 100.0;
+		}
+
+		Proc::hot_columns columns;
+		for (size_t sort_key = 0; const auto& sorting : Proc::sort_vector) {
+			for (const size_t rows : {(size_t)0, (size_t)60}) {
+				uint64_t best = UINT64_MAX, best_fill = UINT64_MAX, best_hot = UINT64_MAX;
+				for (int i = 0; i < 5; i++) {
+					auto start = Tools::time_micros();
+					Proc::proc_sorter(procs, sorting, false, false, rows);
+					best = std::min(best, Tools::time_micros() - start);
+
+					start = Tools::time_micros();
+					columns.fill(procs, sort_key);
+					const auto filled = Tools::time_micros();
+					Proc::proc_sorter(procs, sorting, false, false, rows, &columns);
+					best_fill = std::min(best_fill, filled - start);
+					best_hot = std::min(best_hot, Tools::time_micros() - filled);
+				}
+				fmt::print("{:>8} pids {:<12} {:>4} rows: best {:>7} us  hot columns: fill {:>7} us sort {:>7} us\n",
+					count, sorting, (rows == 0 ? "all"s : std::to_string(rows)), best, best_fill, best_hot);
+			}
+			sort_key++;
+		}
+	}
+
+	//* Alternate the sort direction of the collected list and redraw the process box after each change
+	void run_sort_draw(size_t count) {
+		const auto root = fs::temp_directory_path() / fmt::format("btop_bench_proc_{}", getpid());
+		make_fake_proc(root, count);
+		Shared::procPath = root;
+		Shared::procDir = Tools::DirFd(root);
+		Shared::update_tick();
+
+		Term::width = 200;
+		Term::height = 60;
+		Config::set("shown_boxes", "proc"s);
+		Theme::setTheme();
+		Draw::calcSizes();
+
+		for (const bool tree : {false, true}) {
+			Config::set("proc_tree", tree);
+			for (const std::string sorting : {"pid", "memory", "cpu direct"}) {
+				Config::set("proc_sorting", sorting);
+				Proc::collect();
+				uint64_t best_sort = UINT64_MAX, best_draw = UINT64_MAX;
+				for (int i = 0; i < 6; i++) {
+					Config::set("proc_reversed", i % 2 == 0);
+					const auto start = Tools::time_micros();
+					auto& plist = Proc::collect(true);
+					const auto sorted = Tools::time_micros();
+					Proc::draw(plist, true);
+					const auto drawn = Tools::time_micros();
+					best_sort = std::min(best_sort, sorted - start);
+					best_draw = std::min(best_draw, drawn - sorted);
+				}
+				fmt::print("{:>8} pids {:>5} {:<10}: sort best {:>7} us  draw best {:>7} us\n",
+					count, (tree ? "tree" : "flat"), sorting, best_sort, best_draw);
+			}
+		}
+		Config::set("proc_reversed", false);
+
+		fs::remove_all(root);
+	}
+
+	//* Time updates with the detailed view open on a process with <mappings> entries in smaps, with and without smaps_rollup
+	void run_details(size_t mappings) {
+		const auto root = fs::temp_directory_path() / fmt::format("btop_bench_proc_{}", getpid());
+		make_fake_proc(root, 10);
+		Shared::procPath = root;
+		Shared::procDir = Tools::DirFd(root);
+		Shared::update_tick();
+
+		constexpr std::string_view fields = "Rss:                   4 kB\nPss:                   4 kB\nPss_Dirty:             4 kB\n"
+			"Shared_Clean:          0 kB\nShared_Dirty:          0 kB\nPrivate_Clean:         0 kB\nPrivate_Dirty:         4 kB\n"
+			"Referenced:            4 kB\nAnonymous:             4 kB\nLazyFree:              0 kB\nAnonHugePages:         0 kB\n"
+			"Swap:                  0 kB\nSwapPss:               0 kB\nLocked:                0 kB\n";
+		std::string smaps;
+		for (size_t i = 0; i < mappings; i++)
+			smaps += fmt::format("{:012x}-{:012x} rw-p 00000000 00:00 0\nSize:                  4 kB\n{}VmFlags: rd wr mr mw me ac sd\n", i << 12, (i + 1) << 12, fields);
+		write_file(root / "1" / "smaps", smaps);
+		write_file(root / "1" / "smaps_rollup", fmt::format("{:012x}-{:012x} ---p 00000000 00:00 0 [rollup]\n"
+			"Rss: {} kB\nPss: {} kB\nPrivate_Clean: 0 kB\nPrivate_Dirty: {} kB\nAnonHugePages: 0 kB\nSwap: 0 kB\n", 0, mappings << 12, mappings * 4, mappings * 4, mappings * 4));
+
+		Config::set("show_detailed", true);
+		Config::set("detailed_pid", 1);
+		Config::set("proc_info_smaps", true);
+		for (const bool rollup : {true, false}) {
+			if (not rollup) fs::remove(root / "1" / "smaps_rollup");
+			Proc::collect();
+			uint64_t best = UINT64_MAX;
+			for (int i = 0; i < 5; i++) {
+				const auto start = Tools::time_micros();
+				Proc::collect();
+				best = std::min(best, Tools::time_micros() - start);
+			}
+			fmt::print("{:>8} mappings {:<12}: best {:>9} us  Pss:{} Uss:{} {}\n", mappings, (rollup ? "smaps_rollup" : "smaps"), best,
+				Tools::floating_humanizer(Proc::detailed.pss_bytes.back(), true), Tools::floating_humanizer(Proc::detailed.uss_bytes.back(), true), Proc::detailed.mem_detail);
+		}
+		Config::set("show_detailed", false);
+
+		fs::remove_all(root);
+	}
+}
+
+int main(int argc, char** argv) {
+	Shared::passwd_path.clear();
+	Shared::coreCount = 8;
+	Shared::pageSize = 4096;
+	Shared::clkTck = 100;
+
+	std::vector<size_t> counts;
+	std::vector<int> threads;
+	bool filter{}, sort{}, sort_draw{}, details{};
+	for (int i = 1; i < argc; i++) {
+		if (std::string_view(argv[i]) == "-f")
+			filter = true;
+		else if (std::string_view(argv[i]) == "-s")
+			sort = true;
+		else if (std::string_view(argv[i]) == "-S")
+			sort_draw = true;
+		else if (std::string_view(argv[i]) == "-d")
+			details = true;
+		else if (std::string_view(argv[i]) == "-t" and i + 1 < argc)
+			threads.push_back(std::atoi(argv[++i]));
+		else
+			counts.push_back(std::strtoul(argv[i], nullptr, 10));
+	}
+	if (counts.empty()) counts = {1000, 10000, 50000};
+	if (threads.empty()) threads = {1};
+
+	for (const auto count : counts) {
+		if (details) run_details(count);
+		else if (sort) run_sort(count);
+		else if (sort_draw) run_sort_draw(count);
+		else if (filter) run_filter(count);
+		else run(count, threads);
+	}
+}
@@ -0,0 +1,72 @@
+// SPDX-License-Identifier: Apache-2.0
+
+//* Microbenchmark of the graph histories updated by the collectors every tick, comparing std::deque trimmed with pop_front() to Tools::RingBuffer
+//* The series match the boxes of a machine with the given number of cores: cpu fields, per core usage and temperature, mem, net and disk io
+//* Counts the allocations made per tick by replacing the global operator new
+//* Usage: btop_bench_ring_buffer [cores] [box width] [ticks]
+
+#include <atomic>
+#include <cstdlib>
+#include <deque>
+#include <new>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "btop_tools.hpp"
+
+namespace {
+	std::atomic<uint64_t> allocations{}, allocated_bytes{};
+}
+
+void* operator new(std::size_t size) {
+	allocations.fetch_add(1, std::memory_order_relaxed);
+	allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+	if (void* ptr = std::malloc(size ? size : 1)) return ptr;
+	throw std::bad_alloc();
+}
+
+//? Not inlined, so the compiler doesn't see free() called on pointers from new expressions
+[[gnu::noinline]] void operator delete(void* ptr) noexcept { std::free(ptr); }
+[[gnu::noinline]] void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+namespace {
+	size_t series_count(size_t cores) {
+		//? 11 cpu fields, usage and temperature per core, 6 mem, 2 net and 3 io series for 4 disks
+		return 11 + cores * 2 + 6 + 2 + 3 * 4;
+	}
+
+	template <typename Series, typename Update>
+	void run(const char* name, size_t cores, size_t width, size_t ticks, Update&& update) {
+		std::vector<Series> series(series_count(cores));
+		//? Fill the histories to the graph width first, as after btop has been running for a while
+		for (size_t tick = 0; tick < width * 2; tick++) {
+			for (auto& s : series) update(s, (long long)tick);
+		}
+
+		const uint64_t start_allocs = allocations, start_bytes = allocated_bytes;
+		const auto start = Tools::time_micros();
+		for (size_t tick = 0; tick < ticks; tick++) {
+			for (auto& s : series) update(s, (long long)tick);
+		}
+		const auto elapsed = Tools::time_micros() - start;
+		fmt::print("{:<12} {:>8.2f} allocs/tick {:>10.1f} bytes/tick {:>8.1f} us/tick\n", name,
+			(double)(allocations - start_allocs) / ticks, (double)(allocated_bytes - start_bytes) / ticks, (double)elapsed / ticks);
+	}
+}
+
+int main(int argc, char** argv) {
+	const size_t cores = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 96;
+	const size_t width = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 100;
+	const size_t ticks = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 10000;
+
+	fmt::print("{} cores, {} series of {} values, {} ticks\n", cores, series_count(cores), width * 2, ticks);
+	run<std::deque<long long>>("deque", cores, width, ticks, [&](auto& s, long long value) {
+		s.push_back(value);
+		while (s.size() > width * 2) s.pop_front();
+	});
+	run<Tools::RingBuffer<long long>>("RingBuffer", cores, width, ticks, [&](auto& s, long long value) {
+		s.push_back(value);
+		s.set_capacity(width * 2);
+	});
+}
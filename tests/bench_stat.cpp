@@ -0,0 +1,108 @@
+// SPDX-License-Identifier: Apache-2.0
+
+//* Microbenchmark of /proc/[pid]/stat parsing, comparing Proc::parse_pid_stat() with the earlier parsers
+//* Usage: btop_bench_stat [lines]
+
+#include <algorithm>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "btop_shared.hpp"
+#include "btop_tools.hpp"
+
+namespace {
+	struct parsed {
+		char state{};
+		uint64_t ppid{}, cpu_t{}, threads{}, starttime{}, rss{};
+		int64_t nice{};
+	};
+
+	//* The iostream based parser used before, with the file stream replaced by a string stream
+	bool parse_iostream(const std::string& line, int offset, parsed& out) {
+		std::istringstream pread(line);
+		std::string short_str;
+		int x = 0, next_x = 3;
+		try {
+			for (;;) {
+				while (pread.good() and ++x < next_x + offset) pread.ignore(Tools::SSmax, ' ');
+				if (not pread.good()) break;
+				else getline(pread, short_str, ' ');
+
+				switch (x-offset) {
+					case 3: out.state = short_str.at(0); continue;
+					case 4: out.ppid = stoull(short_str); next_x = 14; continue;
+					case 14: out.cpu_t = stoull(short_str); continue;
+					case 15: out.cpu_t += stoull(short_str); next_x = 19; continue;
+					case 19: out.nice = stoll(short_str); continue;
+					case 20: out.threads = stoull(short_str); next_x = 22; continue;
+					case 22: out.starttime = stoull(short_str); next_x = 24; continue;
+					case 24: out.rss = stoull(short_str);
+				}
+				break;
+			}
+		}
+		catch (const std::exception&) { return false; }
+		return x - offset >= 24;
+	}
+
+	//* Field skipping parser relying on the number of spaces in comm
+	bool parse_offset(std::string_view line, int offset, parsed& out) {
+		Tools::FieldScanner stat(line);
+		uint64_t stime{};
+		stat.skip(2 + offset);
+		const auto state = stat.next();
+		if (state.empty()) return false;
+		out.state = state.front();
+		if (not stat.next(out.ppid) or not stat.skip(9).next(out.cpu_t) or not stat.next(stime)
+		or not stat.skip(3).next(out.nice) or not stat.next(out.threads) or not stat.skip().next(out.starttime)
+		or not stat.skip().next(out.rss))
+			return false;
+		out.cpu_t += stime;
+		return true;
+	}
+
+	template <typename F>
+	void run(const char* name, size_t count, F&& parse) {
+		uint64_t best = UINT64_MAX, check{};
+		for (int round = 0; round < 5; round++) {
+			const auto start = Tools::time_micros();
+			for (size_t i = 0; i < count; i++) check += parse(i);
+			best = std::min(best, Tools::time_micros() - start);
+		}
+		fmt::print("{:<16} {:>8.1f} ns/process  (checksum {})\n", name, (double)best * 1000 / count, check);
+	}
+}
+
+int main(int argc, char** argv) {
+	const size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+	const std::vector<std::string> names = {"systemd", "kworker/3:1H-kblockd", "tmux: server", "Web Content", "php-fpm: pool www"};
+
+	std::vector<std::string> lines;
+	std::vector<int> offsets;
+	lines.reserve(count);
+	for (size_t pid = 1; pid <= count; pid++) {
+		const auto& name = names[pid % names.size()];
+		lines.push_back(fmt::format("{} ({}) S {} {} {} 0 -1 4194560 {} 0 {} 0 {} {} 0 0 20 0 {} 0 {} 12345678 {} "
+			"18446744073709551615 1 1 0 0 0 0 0 3670016 134433283 0 0 0 17 {} 0 0 {} 0 0 0 0 0 0 0 0 0 0\n",
+			pid, name, pid / 8 + 1, pid, pid, pid * 7, pid % 13, pid * 3, pid * 2, pid % 40 + 1, pid * 11, 250 + pid % 500, pid % 8, pid % 5));
+		offsets.push_back(std::ranges::count(name, ' '));
+	}
+
+	fmt::print("{} lines\n", count);
+	run("iostream", count, [&](size_t i) {
+		parsed out;
+		return parse_iostream(lines[i], offsets[i], out) ? out.rss + out.cpu_t : 0;
+	});
+	run("name offset", count, [&](size_t i) {
+		parsed out;
+		return parse_offset(lines[i], offsets[i], out) ? out.rss + out.cpu_t : 0;
+	});
+	run("parse_pid_stat", count, [&](size_t i) {
+		Proc::pid_stat out;
+		return Proc::parse_pid_stat(lines[i], out) ? out.rss + out.utime + out.stime : 0;
+	});
+}
@@ -0,0 +1,96 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "btop_shared.hpp"
+
+namespace fs = std::filesystem;
+
+namespace {
+	//* Fake cgroup v2 hierarchy below a temporary directory, removed when the test ends
+	class CgroupTree : public ::testing::Test {
+	protected:
+		fs::path root;
+
+		void SetUp() override {
+			root = fs::path(::testing::TempDir()) / "btop_cgroup_test";
+			fs::remove_all(root);
+			fs::create_directories(root / "svc" / "worker" / "idle");
+			fs::create_directories(root / "other");
+			write("cgroup.procs", "1\n2\n");
+			write("svc/cgroup.procs", "100\n101\n");
+			write("svc/cpu.stat", "usage_usec 250000\nuser_usec 200000\nsystem_usec 50000\nnr_periods 40\nnr_throttled 3\nthrottled_usec 12000\n");
+			write("svc/io.stat", "8:0 rbytes=4096 wbytes=1024 rios=1 wios=1 dbytes=0 dios=0\n259:0 rbytes=512 wbytes=0 rios=1 wios=0 dbytes=0 dios=0\n");
+			write("svc/memory.current", "1048576\n");
+			write("svc/memory.max", "max\n");
+			write("svc/worker/cgroup.procs", "200\n");
+			write("svc/worker/memory.current", "4096\n");
+			write("svc/worker/memory.max", "8192\n");
+			write("svc/worker/idle/cgroup.procs", "");
+			write("other/cgroup.procs", "300\n");
+		}
+
+		void TearDown() override {
+			fs::remove_all(root);
+		}
+
+		void write(const std::string& file, const std::string& content) {
+			std::ofstream(root / file) << content;
+		}
+	};
+}
+
+TEST_F(CgroupTree, cgroup_dir) {
+	EXPECT_EQ(Shared::cgroup_dir(root, "svc"), root / "svc");
+	EXPECT_EQ(Shared::cgroup_dir(root, "/svc/worker"), root / "svc" / "worker");
+	EXPECT_EQ(Shared::cgroup_dir(root, (root / "svc").string()), root / "svc");
+	EXPECT_EQ(Shared::cgroup_dir(root, "missing"), fs::path{});
+	EXPECT_EQ(Shared::cgroup_dir(root, ""), fs::path{});
+}
+
+TEST_F(CgroupTree, read_cgroup_pids) {
+	std::vector<size_t> pids;
+	ASSERT_TRUE(Shared::read_cgroup_pids(root / "svc", pids));
+	std::ranges::sort(pids);
+	EXPECT_EQ(pids, (std::vector<size_t>{100, 101, 200}));
+
+	pids.clear();
+	ASSERT_TRUE(Shared::read_cgroup_pids(root / "svc" / "worker" / "idle", pids));
+	EXPECT_TRUE(pids.empty());
+
+	EXPECT_FALSE(Shared::read_cgroup_pids(root / "missing", pids));
+}
+
+TEST_F(CgroupTree, read_cgroup_stats) {
+	Shared::cgroup_stats stats;
+	ASSERT_TRUE(Shared::read_cgroup_stats(root / "svc", stats));
+	EXPECT_EQ(stats.usage_usec, 250000);
+	EXPECT_EQ(stats.nr_throttled, 3);
+	EXPECT_EQ(stats.throttled_usec, 12000);
+	EXPECT_EQ(stats.mem_current, 1048576);
+	EXPECT_EQ(stats.mem_max, 0);
+	//? Summed over both devices
+	EXPECT_TRUE(stats.has_io);
+	EXPECT_EQ(stats.io_read, 4096 + 512);
+	EXPECT_EQ(stats.io_write, 1024);
+
+	//? Cpu controller not enabled
+	ASSERT_TRUE(Shared::read_cgroup_stats(root / "svc" / "worker", stats));
+	EXPECT_EQ(stats.usage_usec, 0);
+	EXPECT_EQ(stats.nr_throttled, 0);
+	EXPECT_EQ(stats.throttled_usec, 0);
+	EXPECT_EQ(stats.mem_current, 4096);
+	EXPECT_EQ(stats.mem_max, 8192);
+	//? Io controller not enabled
+	EXPECT_FALSE(stats.has_io);
+	EXPECT_EQ(stats.io_read, 0);
+	EXPECT_EQ(stats.io_write, 0);
+
+	EXPECT_FALSE(Shared::read_cgroup_stats(root / "other", stats));
+}
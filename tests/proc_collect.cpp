@@ -0,0 +1,148 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "btop_config.hpp"
+#include "btop_shared.hpp"
+#include "btop_tools.hpp"
+
+namespace fs = std::filesystem;
+
+namespace Shared {
+	extern fs::path procPath, passwd_path;
+	extern long pageSize, clkTck;
+	extern Tools::DirFd procDir;
+}
+
+namespace {
+	//* Fake /proc for Proc::collect() with a shell (pid 1) running three workers (pid 2-4), the first of which runs another worker (pid 5)
+	class FakeProc : public ::testing::Test {
+	protected:
+		fs::path root;
+
+		void SetUp() override {
+			root = fs::path(::testing::TempDir()) / "btop_proc_collect_test";
+			fs::remove_all(root);
+			fs::create_directories(root);
+			write(root / "stat", "cpu  10000 200 3000 400000 500 0 60 0 0 0\n");
+			write(root / "uptime", "12345.67 98765.43\n");
+			write(root / "meminfo", "MemTotal:       65536000 kB\nMemFree:        32768000 kB\n");
+			add_pid(1, 0, "shell", 100);
+			add_pid(2, 1, "worker", 200);
+			add_pid(3, 1, "worker", 300);
+			add_pid(4, 1, "worker", 400);
+			add_pid(5, 2, "worker", 500);
+
+			Shared::passwd_path.clear();
+			Shared::coreCount = 8;
+			Shared::pageSize = 4096;
+			Shared::clkTck = 100;
+			Shared::procPath = root;
+			Shared::procDir = Tools::DirFd(root);
+			Shared::update_tick();
+			Config::set("proc_sorting", "pid"s);
+		}
+
+		void TearDown() override {
+			Config::set("proc_tree", false);
+			Config::set("proc_aggregate", false);
+			Config::set("proc_group_programs", false);
+			Config::set("proc_filter_kernel", false);
+			fs::remove_all(root);
+		}
+
+		void write(const fs::path& path, const std::string& content) {
+			std::ofstream(path) << content;
+		}
+
+		//? Kernel threads have PF_KTHREAD (0x200000) set in the flags and an empty command line
+		void add_pid(size_t pid, size_t ppid, const std::string& name, size_t rss_pages, bool kernel = false, size_t starttime = 0) {
+			const auto dir = root / std::to_string(pid);
+			fs::create_directories(dir);
+			write(dir / "comm", name + '\n');
+			write(dir / "cmdline", (kernel ? ""s : fmt::format("/usr/bin/{}{}", name, '\0')));
+			write(dir / "status", fmt::format("Name:\t{}\nState:\tS (sleeping)\nUid:\t{}\t0\t0\t0\n", name, (kernel ? 0 : 1000)));
+			write(dir / "stat", fmt::format("{} ({}) S {} {} 0 0 -1 {} 0 0 0 0 0 0 0 0 20 0 1 0 {} 1000000 {} 0\n",
+				pid, name, ppid, pid, (kernel ? 0x200000 : 0x400000), (starttime > 0 ? starttime : pid), rss_pages));
+			write(dir / "statm", fmt::format("1000 {} 100 1 0 200 0\n", rss_pages));
+		}
+
+		static auto find(const std::vector<Proc::proc_info>& procs, size_t pid) -> const Proc::proc_info& {
+			return *std::ranges::find(procs, pid, &Proc::proc_info::pid);
+		}
+	};
+}
+
+TEST_F(FakeProc, tree_accumulation_independent_of_program_view) {
+	Config::set("proc_tree", true);
+	Config::set("proc_aggregate", true);
+	Config::set("proc_group_programs", false);
+
+	//? Tree view with accumulation, every parent holds the memory of its descendants
+	const auto& tree = Proc::collect();
+	ASSERT_EQ(tree.size(), 5);
+	EXPECT_EQ(find(tree, 1).mem, (100 + 200 + 300 + 400 + 500) * 4096);
+	EXPECT_EQ(find(tree, 2).mem, (200 + 500) * 4096);
+	EXPECT_EQ(find(tree, 5).mem, 500 * 4096);
+
+	//? Program view with tree view and accumulation still enabled, each process is only counted once
+	Config::set("proc_group_programs", true);
+	auto rows = Proc::collect();
+	ASSERT_EQ(rows.size(), 5);
+	EXPECT_EQ(find(rows, 1).mem, 100 * 4096);
+	EXPECT_EQ(find(rows, 2).mem, 200 * 4096);
+	Proc::aggregate(rows, "memory", false);
+	ASSERT_EQ(rows.size(), 2);
+	EXPECT_EQ(rows[0].name.get(), "worker");
+	EXPECT_EQ(rows[0].group_count, 4);
+	EXPECT_EQ(rows[0].mem, (200 + 300 + 400 + 500) * 4096);
+	EXPECT_EQ(rows[1].mem, 100 * 4096);
+
+	//? Leaving the program view doesn't change the accumulation setting
+	EXPECT_TRUE(Config::getB("proc_aggregate"));
+	Config::set("proc_group_programs", false);
+	EXPECT_EQ(find(Proc::collect(), 1).mem, (100 + 200 + 300 + 400 + 500) * 4096);
+
+	//? Tree view without accumulation
+	Config::set("proc_aggregate", false);
+	EXPECT_EQ(find(Proc::collect(), 1).mem, 100 * 4096);
+}
+
+TEST_F(FakeProc, tree_siblings_sorted_by_accumulated_values) {
+	Config::set("proc_tree", true);
+	Config::set("proc_sorting", "memory"s);
+	auto order = [](const std::vector<Proc::proc_info>& procs) {
+		std::vector<size_t> pids;
+		for (const auto& p : procs) pids.push_back(p.pid);
+		return pids;
+	};
+
+	//? With accumulation pid 2 holds the memory of pid 5 and comes before its larger siblings
+	Config::set("proc_aggregate", true);
+	EXPECT_EQ(order(Proc::collect()), (std::vector<size_t>{1, 2, 5, 4, 3}));
+
+	Config::set("proc_aggregate", false);
+	EXPECT_EQ(order(Proc::collect()), (std::vector<size_t>{1, 4, 3, 2, 5}));
+}
+
+TEST_F(FakeProc, reused_kernel_thread_pid) {
+	Config::set("proc_filter_kernel", true);
+	add_pid(6, 0, "kworker/0:1", 0, true, 50);
+
+	//? Hidden when first read and when skipped as a known kernel thread
+	auto has_pid = [](const std::vector<Proc::proc_info>& procs, size_t pid) { return std::ranges::find(procs, pid, &Proc::proc_info::pid) != procs.end(); };
+	EXPECT_FALSE(has_pid(Proc::collect(), 6));
+	EXPECT_FALSE(has_pid(Proc::collect(), 6));
+	EXPECT_EQ(Proc::collect().size(), 5);
+
+	//? A user process that reuses the pid is shown on the next update
+	add_pid(6, 1, "worker", 600, false, 900);
+	EXPECT_TRUE(has_pid(Proc::collect(), 6));
+}
@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "btop_shared.hpp"
+
+namespace {
+	auto make_proc(size_t pid, std::string name, std::string cmd, std::string user) -> Proc::proc_info {
+		Proc::proc_info proc{pid};
+		proc.name = std::move(name);
+		proc.cmd = std::move(cmd);
+		proc.user = std::move(user);
+		return proc;
+	}
+}
+
+TEST(proc, matches_filter) {
+	auto proc = make_proc(4242, "tmux: server", "tmux new -s main", "alice");
+	EXPECT_TRUE(Proc::matches_filter(proc, ""));
+	EXPECT_TRUE(Proc::matches_filter(proc, "424"));
+	EXPECT_TRUE(Proc::matches_filter(proc, "TMUX"));
+	EXPECT_TRUE(Proc::matches_filter(proc, "-s MAIN"));
+	EXPECT_TRUE(Proc::matches_filter(proc, "Alice"));
+	EXPECT_FALSE(Proc::matches_filter(proc, "bob"));
+	EXPECT_FALSE(Proc::matches_filter(proc, "4243"));
+}
+
+TEST(proc, matches_filter_regex) {
+	auto proc = make_proc(4242, "tmux: server", "tmux new -s main", "alice");
+	EXPECT_TRUE(Proc::matches_filter(proc, "!"));
+	EXPECT_TRUE(Proc::matches_filter(proc, "!^42.2$"));
+	EXPECT_TRUE(Proc::matches_filter(proc, "!^tmux"));
+	EXPECT_TRUE(Proc::matches_filter(proc, "!tmux .* main"));
+	//? The command line has to match as a whole
+	EXPECT_FALSE(Proc::matches_filter(proc, "!new"));
+	EXPECT_FALSE(Proc::matches_filter(proc, "!^bob$"));
+	//? An incomplete regex matches nothing
+	EXPECT_FALSE(Proc::matches_filter(proc, "!tmux("));
+}
+
+TEST(proc, matches_filter_cached) {
+	auto bash = make_proc(100, "bash", "/bin/bash", "root");
+	auto vim = make_proc(200, "vim", "vim notes.txt", "root");
+
+	//? Typing narrows the matches, deleting widens them again
+	for (const std::string filter : {"b", "ba", "bas", "bash", "bas", "ba", "b", ""}) {
+		EXPECT_TRUE(Proc::matches_filter(bash, filter)) << filter;
+		EXPECT_EQ(Proc::matches_filter(vim, filter), filter.empty()) << filter;
+	}
+	EXPECT_TRUE(Proc::matches_filter(vim, "vi"));
+	EXPECT_TRUE(Proc::matches_filter(vim, "notes"));
+	EXPECT_FALSE(Proc::matches_filter(vim, "notes.md"));
+	EXPECT_TRUE(Proc::matches_filter(vim, "notes"));
+
+	//? A changed command line is only seen after the cached result is reset
+	vim.cmd = "vim notes.md";
+	vim.filter_gen = 0;
+	EXPECT_TRUE(Proc::matches_filter(vim, "notes.md"));
+	EXPECT_FALSE(Proc::matches_filter(bash, "notes.md"));
+}
@@ -0,0 +1,132 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "btop_shared.hpp"
+
+namespace {
+	//* Processes with few distinct values so that most keys are shared by several processes
+	auto make_procs(size_t count, std::mt19937& rng) -> std::vector<Proc::proc_info> {
+		std::vector<Proc::proc_info> procs;
+		for (size_t i = 0; i < count; i++) {
+			auto& p = procs.emplace_back(Proc::proc_info{rng() % 100000});
+			p.name = fmt::format("{}worker{}", (rng() % 3 == 0 ? "kernel_" : ""), rng() % 7);
+			p.cmd = fmt::format("/usr/bin/{} --id={}", p.name, rng() % 5);
+			p.user = (rng() % 2 ? "root" : "user");
+			p.threads = rng() % 4;
+			p.mem = (rng() % 6) * 4096;
+			p.cpu_p = (rng() % 4 == 0 ? (rng() % 900) / 10.0 : 0.0);
+			p.cpu_c = (rng() % 5) / 4.0;
+		}
+		return procs;
+	}
+
+	auto pids(const std::vector<Proc::proc_info>& procs, size_t count) -> std::vector<size_t> {
+		std::vector<size_t> out;
+		for (size_t i = 0; i < std::min(count, procs.size()); i++) out.push_back(procs[i].pid);
+		return out;
+	}
+}
+
+//? Partially ordered lists must show the same first rows as a full stable sort, including the "cpu lazy" reordering
+TEST(proc, proc_sorter_partial) {
+	std::mt19937 rng(1234);
+	for (const auto& sorting : Proc::sort_vector) {
+		for (const bool reverse : {false, true}) {
+			for (const size_t rows : {1, 7, 40, 150}) {
+				const auto procs = make_procs(300, rng);
+				auto full = procs;
+				auto partial = procs;
+				Proc::proc_sorter(full, sorting, reverse, false);
+				Proc::proc_sorter(partial, sorting, reverse, false, rows);
+				EXPECT_EQ(pids(full, rows), pids(partial, rows)) << sorting << (reverse ? " reversed" : "") << " rows " << rows;
+				EXPECT_TRUE(std::is_permutation(full.begin(), full.end(), partial.begin(), [](const auto& a, const auto& b) { return a.pid == b.pid; }));
+			}
+		}
+	}
+}
+
+TEST(proc, proc_sorter_stable) {
+	std::mt19937 rng(42);
+	for (const auto& sorting : {"pid"s, "name"s, "command"s, "threads"s, "user"s, "memory"s, "cpu direct"s}) {
+		for (const bool reverse : {false, true}) {
+			const auto procs = make_procs(300, rng);
+			auto sorted = procs;
+			auto expected = procs;
+			Proc::proc_sorter(sorted, sorting, reverse, false);
+			std::stable_sort(expected.begin(), expected.end(), [&](const auto& a, const auto& b) {
+				const auto& [x, y] = (reverse ? std::tie(b, a) : std::tie(a, b));
+				if (sorting == "pid") return y.pid < x.pid;
+				if (sorting == "name") return x.name < y.name;
+				if (sorting == "command") return x.cmd < y.cmd;
+				if (sorting == "threads") return y.threads < x.threads;
+				if (sorting == "user") return x.user < y.user;
+				if (sorting == "memory") return y.mem < x.mem;
+				return y.cpu_p < x.cpu_p;
+			});
+			EXPECT_EQ(pids(expected, procs.size()), pids(sorted, procs.size())) << sorting << (reverse ? " reversed" : "");
+		}
+	}
+}
+
+//? Keys read from hot columns must give the same order as keys read from the processes
+TEST(proc, proc_sorter_hot_columns) {
+	std::mt19937 rng(99);
+	Proc::hot_columns columns;
+	for (size_t sort_key = 0; const auto& sorting : Proc::sort_vector) {
+		for (const bool reverse : {false, true}) {
+			for (const size_t rows : {0, 7, 40}) {
+				const auto procs = make_procs(300, rng);
+				auto expected = procs;
+				auto sorted = procs;
+				columns.fill(sorted, sort_key);
+				Proc::proc_sorter(expected, sorting, reverse, false, rows);
+				Proc::proc_sorter(sorted, sorting, reverse, false, rows, &columns);
+				EXPECT_EQ(pids(expected, (rows == 0 ? procs.size() : rows)), pids(sorted, (rows == 0 ? procs.size() : rows)))
+					<< sorting << (reverse ? " reversed" : "") << " rows " << rows;
+			}
+		}
+		sort_key++;
+	}
+}
+
+TEST(proc, aggregate) {
+	std::mt19937 rng(7);
+	auto procs = make_procs(300, rng);
+	procs[0].filtered = true;
+	procs[1].fds = 5;
+
+	double cpu_total{};
+	uint64_t mem_total{};
+	for (const auto& p : procs) {
+		if (p.filtered) continue;
+		cpu_total += p.cpu_p;
+		mem_total += p.mem;
+	}
+
+	auto rows = procs;
+	Proc::aggregate(rows, "memory", false);
+	EXPECT_EQ(Proc::numpids, (int)rows.size());
+	EXPECT_TRUE(std::is_sorted(rows.begin(), rows.end(), [](const auto& a, const auto& b) { return a.mem > b.mem; }));
+
+	size_t count{};
+	double cpu_sum{};
+	uint64_t mem_sum{};
+	for (const auto& row : rows) {
+		EXPECT_EQ(std::ranges::count(rows, row.name, &Proc::proc_info::name), 1) << row.name.get();
+		EXPECT_EQ(row.group_count, (size_t)std::ranges::count_if(procs, [&](const auto& p) { return not p.filtered and p.name == row.name; })) << row.name.get();
+		count += row.group_count;
+		cpu_sum += row.cpu_p;
+		mem_sum += row.mem;
+		EXPECT_EQ(row.fds, (row.name == procs[1].name ? 5 : -1)) << row.name.get();
+	}
+	EXPECT_EQ(count, procs.size() - 1);
+	EXPECT_NEAR(cpu_sum, cpu_total, 1e-6);
+	EXPECT_EQ(mem_sum, mem_total);
+}
@@ -0,0 +1,73 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <string_view>
+
+#include <gtest/gtest.h>
+
+#include "btop_shared.hpp"
+
+TEST(proc, parse_pid_stat) {
+	constexpr std::string_view line = "4242 (tmux: server) S 1 4242 4242 0 -1 4194560 1234 0 56 0 700 300 0 0 20 0 1 0 8765 12345678 910 "
+									  "18446744073709551615 1 1 0 0 0 0 0 3670016 134433283 0 0 0 17 3 0 0 12 0 0 0 0 0 0 0 0 0 0\n";
+	Proc::pid_stat stat;
+	ASSERT_TRUE(Proc::parse_pid_stat(line, stat));
+	EXPECT_EQ(stat.name, "tmux: server");
+	EXPECT_EQ(stat.state, 'S');
+	EXPECT_EQ(stat.ppid, 1);
+	EXPECT_EQ(stat.flags, 4194560);
+	EXPECT_EQ(stat.minflt, 1234);
+	EXPECT_EQ(stat.majflt, 56);
+	EXPECT_EQ(stat.utime, 700);
+	EXPECT_EQ(stat.stime, 300);
+	EXPECT_EQ(stat.priority, 20);
+	EXPECT_EQ(stat.nice, 0);
+	EXPECT_EQ(stat.threads, 1);
+	EXPECT_EQ(stat.starttime, 8765);
+	EXPECT_EQ(stat.rss, 910);
+	EXPECT_EQ(stat.processor, 3);
+	EXPECT_EQ(stat.rt_priority, 0);
+	EXPECT_EQ(stat.blkio_ticks, 12);
+}
+
+TEST(proc, parse_pid_stat_odd_names) {
+	Proc::pid_stat stat;
+	ASSERT_TRUE(Proc::parse_pid_stat("7 (a) b (c)) R 2 0 0 0 -1 0 0 0 0 0 1 2 0 0 -5 -10 4 0 99 0 5", stat));
+	EXPECT_EQ(stat.name, "a) b (c)");
+	EXPECT_EQ(stat.state, 'R');
+	EXPECT_EQ(stat.ppid, 2);
+	EXPECT_EQ(stat.nice, -10);
+	EXPECT_EQ(stat.rss, 5);
+	//? Fields after rss are optional
+	EXPECT_EQ(stat.processor, 0);
+
+	ASSERT_TRUE(Proc::parse_pid_stat("8 (new\nline) S 1 0 0 0 -1 0 0 0 0 0 0 0 0 0 20 0 1 0 1 0 1", stat));
+	EXPECT_EQ(stat.name, "new\nline");
+
+	EXPECT_FALSE(Proc::parse_pid_stat("9 (truncated) S 1 0 0", stat));
+	EXPECT_FALSE(Proc::parse_pid_stat("", stat));
+}
+
+TEST(cpu, parse_cpu_stat_line) {
+	Cpu::cpu_stat_line line;
+	ASSERT_TRUE(Cpu::parse_cpu_stat_line("cpu  100 20 30 4000 50 6 7 8 90 10\n", line));
+	EXPECT_EQ(line.core, -1);
+	EXPECT_EQ(line.count, 10);
+	EXPECT_EQ(line.fields[2], 30);
+	EXPECT_EQ(line.fields[9], 10);
+	//? guest and guest_nice are not added to the total
+	EXPECT_EQ(line.total, 100 + 20 + 30 + 4000 + 50 + 6 + 7 + 8);
+	EXPECT_EQ(line.idle, 4000 + 50);
+
+	ASSERT_TRUE(Cpu::parse_cpu_stat_line("cpu511 1 2 3 4 5 6 7 8 9 10 11 12", line));
+	EXPECT_EQ(line.core, 511);
+	EXPECT_EQ(line.count, 12);
+	EXPECT_EQ(line.total, 36);
+
+	//? Kernels before 2.6 only have user, nice, system and idle
+	ASSERT_TRUE(Cpu::parse_cpu_stat_line("cpu3 1 2 3 4", line));
+	EXPECT_EQ(line.core, 3);
+	EXPECT_EQ(line.idle, 4);
+
+	EXPECT_FALSE(Cpu::parse_cpu_stat_line("cpu3 1 2 3", line));
+	EXPECT_FALSE(Cpu::parse_cpu_stat_line("cpux 1 2 3 4", line));
+}
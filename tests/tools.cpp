@@ -1,11 +1,24 @@
 // SPDX-License-Identifier: Apache-2.0
 
+#include <array>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
 #include <vector>
 
+#include <fcntl.h>
+
 #include <gtest/gtest.h>
 
 #include "btop_tools.hpp"
 
+namespace {
+	enum class color { red, green, blue };
+	constexpr std::array color_names { std::string_view{"red"}, std::string_view{"green"}, std::string_view{"blue"} };
+}
+
 TEST(tools, string_split) {
 	EXPECT_EQ(Tools::ssplit(""), std::vector<std::string> {});
 	EXPECT_EQ(Tools::ssplit("foo"), std::vector<std::string> { "foo" });
@@ -21,3 +34,141 @@ TEST(tools, string_split) {
 		EXPECT_EQ(actual, expected);
 	}
 }
+
+TEST(tools, field_scanner) {
+	Tools::FieldScanner scanner("123 (name) S  -7\t42\nnext line");
+	int pid{}, nice{};
+	uint64_t value{};
+	EXPECT_TRUE(scanner.next(pid));
+	EXPECT_EQ(pid, 123);
+	EXPECT_EQ(scanner.next(), "(name)");
+	EXPECT_FALSE(scanner.next(value));
+	EXPECT_EQ(value, 0);
+	EXPECT_TRUE(scanner.next(nice));
+	EXPECT_EQ(nice, -7);
+	EXPECT_TRUE(scanner.next(value));
+	EXPECT_EQ(value, 42);
+	EXPECT_EQ(scanner.line(), "");
+	EXPECT_EQ(scanner.line(), "next line");
+	EXPECT_TRUE(scanner.empty());
+	EXPECT_EQ(scanner.next(), "");
+}
+
+TEST(tools, find_key) {
+	constexpr std::string_view status = "Name:\tbtop\nUid:\t1000\t1000\t1000\t1000\nVmRSS:     1234 kB\n";
+	EXPECT_EQ(Tools::find_key(status, "Uid"), "1000\t1000\t1000\t1000");
+	EXPECT_EQ(Tools::find_key(status, "VmRSS"), "1234 kB");
+	EXPECT_EQ(Tools::find_key(status, "Vm"), std::nullopt);
+	EXPECT_EQ(Tools::find_key(status, "Gid"), std::nullopt);
+}
+
+TEST(tools, file_fd) {
+	const std::string path = ::testing::TempDir() + "btop_file_fd_test";
+	std::ofstream(path) << "first\n";
+	Tools::FileFd file(AT_FDCWD, path.c_str());
+	ASSERT_TRUE(file);
+	EXPECT_EQ(file.read(), "first\n");
+	EXPECT_EQ(file.read(3), "fir");
+
+	//? Reads start from the beginning and see the current contents
+	std::ofstream(path) << "second\n";
+	EXPECT_EQ(file.read(), "second\n");
+
+	Tools::FileFd moved(std::move(file));
+	EXPECT_FALSE(file);
+	EXPECT_EQ(file.read(), std::nullopt);
+	EXPECT_EQ(moved.read(), "second\n");
+	std::remove(path.c_str());
+
+	EXPECT_FALSE(Tools::FileFd(AT_FDCWD, "/nonexistent/btop_file_fd_test"));
+}
+
+TEST(tools, count_humanizer) {
+	EXPECT_EQ(Tools::count_humanizer(0), "0");
+	EXPECT_EQ(Tools::count_humanizer(999.4), "999");
+	EXPECT_EQ(Tools::count_humanizer(999.6), "1.0k");
+	EXPECT_EQ(Tools::count_humanizer(1234), "1.2k");
+	EXPECT_EQ(Tools::count_humanizer(34'000'000), "34M");
+	EXPECT_EQ(Tools::count_humanizer(5e12), "5.0T");
+}
+
+TEST(tools, interned_string) {
+	Tools::InternedString a{"worker"}, b{std::string("worker")}, empty;
+	EXPECT_EQ(&a.get(), &b.get());
+	EXPECT_EQ(a, b);
+	EXPECT_EQ(a, "worker");
+	EXPECT_EQ(a, std::string("worker"));
+	EXPECT_TRUE(empty.empty());
+	EXPECT_EQ(empty.get(), "");
+	EXPECT_LT(a, Tools::InternedString{"zsh"});
+
+	//? Strings can be interned again after every holder released them
+	a.clear();
+	b = "bash";
+	Tools::InternedString c{"worker"};
+	EXPECT_EQ(c, "worker");
+	EXPECT_EQ(b.get(), "bash");
+}
+
+TEST(tools, enum_map) {
+	using ColorMap = Tools::EnumMap<color, int, color_names>;
+	static_assert(ColorMap::find("green") == color::green);
+	static_assert(not ColorMap::find("yellow").has_value());
+	static_assert(ColorMap::name(color::blue) == "blue");
+
+	ColorMap map;
+	map[color::red] = 1;
+	map["green"] = 2;
+	map.at("blue") = 3;
+	EXPECT_EQ(map[color::green], 2);
+	EXPECT_EQ(map.at("red"), 1);
+	EXPECT_TRUE(map.contains("blue"));
+	EXPECT_FALSE(map.contains("yellow"));
+	EXPECT_THROW(map.at("yellow"), std::out_of_range);
+	EXPECT_EQ(Tools::safeVal(map, "yellow", -1), -1);
+
+	std::vector<std::string> names;
+	int sum{};
+	for (const auto& [name, value] : map) {
+		names.push_back(name);
+		sum += value;
+	}
+	EXPECT_EQ(names, (std::vector<std::string>{"red", "green", "blue"}));
+	EXPECT_EQ(sum, 6);
+}
+
+TEST(tools, ring_buffer) {
+	Tools::RingBuffer<long long> ring{1, 2};
+	for (long long i = 3; i <= 5; i++) ring.push_back(i);
+	EXPECT_EQ(ring.size(), 5);
+	EXPECT_EQ(ring.front(), 1);
+	EXPECT_EQ(ring.back(), 5);
+
+	//? Lowering the capacity keeps the newest values, pushing at capacity evicts the oldest
+	ring.set_capacity(3);
+	EXPECT_EQ(std::vector<long long>(ring.begin(), ring.end()), (std::vector<long long>{3, 4, 5}));
+	ring.push_back(6);
+	ring.push_back(7);
+	EXPECT_EQ(ring.size(), 3);
+	EXPECT_EQ(std::vector<long long>(ring.begin(), ring.end()), (std::vector<long long>{5, 6, 7}));
+	EXPECT_EQ(*ring.rbegin(), 7);
+	EXPECT_EQ(ring[0], 5);
+	EXPECT_THROW(ring.at(3), std::out_of_range);
+
+	//? The values wrap around the buffer, so they are split over both spans
+	const auto [first, second] = ring.spans();
+	std::vector<long long> joined(first.begin(), first.end());
+	joined.insert(joined.end(), second.begin(), second.end());
+	EXPECT_FALSE(second.empty());
+	EXPECT_EQ(joined, (std::vector<long long>{5, 6, 7}));
+
+	ring.set_capacity(5);
+	ring.push_back(8);
+	EXPECT_EQ(std::vector<long long>(ring.begin(), ring.end()), (std::vector<long long>{5, 6, 7, 8}));
+	ring.pop_front();
+	EXPECT_EQ(ring.front(), 6);
+
+	ring.set_capacity(0);
+	ring.push_back(9);
+	EXPECT_TRUE(ring.empty());
+}